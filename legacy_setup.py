@@ -184,8 +184,9 @@ def install_scs(**kwargs):
     extra_link_args = []
     libraries = []
     sources = (
-        ["scs/scspy.c"]
-        + glob("scs_source/src/*.c")
+        ["scs/scspy.c", "scs/scsprogress.c"]
+        # scsprogress.c compiles ctrlc.c itself
+        + [f for f in glob("scs_source/src/*.c") if not f.endswith("ctrlc.c")]
         + glob("scs_source/linsys/*.c")
     )
     include_dirs = ["scs_source/include", "scs_source/linsys"]
@@ -1,15 +1,17 @@
 #!/usr/bin/env python
+# Only modules that numpy loads anyway are imported here, so `import scs`
+# stays cheap; the rest are imported by the functions that use them.
+import _thread
+import collections
 import enum
+import importlib
+import os
+import struct
 import sys
+import types
 import numpy as np
-from scipy import sparse
-from scs import _scs_direct
 import warnings
 
-__version__ = _scs_direct.version()
-__sizeof_int__ = _scs_direct.sizeof_int()
-__sizeof_float__ = _scs_direct.sizeof_float()
-
 
 # SCS return integers correspond to one of these flags:
 # (copied from scs/include/glbopts.h)
@@ -38,25 +40,59 @@ class LinearSolver(enum.Enum):
 
 
 def _load_module(name):
-  from importlib import import_module
-  return import_module(f"scs.{name}")
+  return importlib.import_module(f"scs.{name}")
+
+
+def _direct():
+  """The default (QDLDL) extension module, imported on first use."""
+  return importlib.import_module("scs._scs_direct")
+
+
+# Module attributes that need an extension module, which `import scs` does
+# not load (see preload): computed on first access, then stored.
+_LAZY_ATTRS = {
+    "__version__": "version",
+    "__sizeof_int__": "sizeof_int",
+    "__sizeof_float__": "sizeof_float",
+}
+
+
+def __getattr__(name):
+  if name == "_scs_direct":
+    return _direct()
+  if name in _LAZY_ATTRS:
+    value = getattr(_direct(), _LAZY_ATTRS[name])()
+    globals()[name] = value
+    return value
+  raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
 
 
 def _resolve_auto():
   """Auto-detect the best available direct solver for this platform."""
   if sys.platform == "darwin":
     # Prefer the bundled QDLDL on macOS over Apple Accelerate.
-    return _scs_direct
+    return _direct()
   try:
     return _load_module("_scs_mkl")
   except ImportError:
     pass
-  return _scs_direct
+  return _direct()
+
+
+_auto_module = None
+
+
+def _auto():
+  """`_resolve_auto`, run once per process."""
+  global _auto_module
+  if _auto_module is None:
+    _auto_module = _resolve_auto()
+  return _auto_module
 
 
 _SOLVER_DISPATCH = {
-    LinearSolver.AUTO: _resolve_auto,
-    LinearSolver.QDLDL: lambda: _scs_direct,
+    LinearSolver.AUTO: _auto,
+    LinearSolver.QDLDL: _direct,
     LinearSolver.CPU_INDIRECT: lambda: _load_module("_scs_indirect"),
     LinearSolver.MKL: lambda: _load_module("_scs_mkl"),
     LinearSolver.ACCELERATE: lambda: _load_module("_scs_accelerate"),
@@ -74,6 +110,96 @@ def _select_scs_module(stgs):
   return _SOLVER_DISPATCH[linear_solver]()
 
 
+def preload(linear_solver=LinearSolver.AUTO):
+  """Load the extension module of a linear solver backend now.
+
+  `import scs` loads no extension module; each is imported by the first
+  instance that uses it. Call this at startup (e.g. outside the request
+  path of a serverless handler) to pay that cost up front.
+
+  @param linear_solver `LinearSolver` (or its value) to load.
+  """
+  _select_scs_module({"linear_solver": linear_solver})
+
+
+def _int_dtype(_scs):
+  """Numpy dtype of the integers used by SCS extension module `_scs`."""
+  return np.dtype(f"i{_scs.sizeof_int()}")
+
+
+def _check_num_threads(_scs, stgs):
+  if stgs.get("num_threads", 0) > 1 and not _scs.has_openmp():
+    warnings.warn(
+        "num_threads has no effect: this SCS extension was built without "
+        "OpenMP (see the use_openmp build option)."
+    )
+
+
+def _sparse():
+  """scipy.sparse, imported on first use."""
+  from scipy import sparse
+  return sparse
+
+
+def _issparse(x):
+  """Whether `x` is a scipy sparse matrix, without importing scipy: if it
+  is not imported yet, `x` cannot be one."""
+  sparse = sys.modules.get("scipy.sparse")
+  return sparse is not None and sparse.issparse(x)
+
+
+class _RawCSC(collections.namedtuple("_RawCSC", "data indices indptr shape")):
+  """A CSC matrix given as a `(data, indices, indptr)` tuple of arrays.
+
+  `data` must be floating point and the index arrays integers. Other
+  widths than the extension's (float64, `scs.__sizeof_int__`) are accepted
+  but converted with a copy at setup, as reported by `converted_inputs`.
+  """
+  __slots__ = ()
+
+  @classmethod
+  def from_tuple(cls, M, shape, name):
+    if len(M) != 3:
+      raise ValueError(f"{name} tuple must be (data, indices, indptr)")
+    data, indices, indptr = (np.asarray(a) for a in M)
+    if data.dtype.kind != "f":
+      raise TypeError(f"{name} data must be a floating point array, not "
+                      f"{data.dtype}")
+    if indices.dtype.kind not in "iu" or indptr.dtype.kind not in "iu":
+      raise TypeError(f"{name} indices and indptr must be integer arrays, "
+                      f"not {indices.dtype} and {indptr.dtype}")
+    if (indptr.shape != (shape[1] + 1,) or indices.ndim != 1
+        or data.shape != indices.shape or indptr[0] != 0
+        or indptr[-1] != len(indices) or np.any(indptr[1:] < indptr[:-1])
+        or np.any(indices < 0) or np.any(indices >= shape[0])):
+      raise ValueError(f"{name} arrays do not form a CSC matrix of shape "
+                       f"{shape}")
+    return cls(data, indices, indptr, shape)
+
+  @property
+  def nnz(self):
+    return len(self.indices)
+
+
+def _canonical_csc(data, indices, indptr, upper):
+  """Sort the row indices within each column of CSC arrays and, if `upper`,
+  drop the strictly lower triangular entries: numpy-only counterpart of
+  scipy's `sorted_indices()` and `triu()`. Returns the input arrays
+  themselves when there is nothing to change."""
+  n = len(indptr) - 1
+  cols = np.repeat(np.arange(n), np.diff(indptr))
+  if np.any((indices[1:] < indices[:-1]) & (cols[1:] == cols[:-1])):
+    order = np.lexsort((indices, cols))
+    data, indices = data[order], indices[order]
+  if upper:
+    keep = indices <= cols
+    if not keep.all():
+      data, indices = data[keep], indices[keep]
+      indptr = np.concatenate(
+          ([0], np.cumsum(np.bincount(cols[keep], minlength=n))))
+  return data, indices, indptr
+
+
 def _has_lower_tri(P):
   """Fast check for strictly lower triangular entries in a sorted CSC matrix."""
   nnz_per_col = np.diff(P.indptr)
@@ -84,106 +210,770 @@ def _has_lower_tri(P):
   return bool(np.any(last_row > np.where(nonempty)[0]))
 
 
-class SCS(object):
+class _IndexCache(object):
+  """Process-wide LRU cache of canonical CSC index arrays.
 
-  def __init__(self, data, cone, **settings):
-    """Initialize the SCS solver.
+  An entry holds what the Python side derives from a sparsity pattern
+  alone: sorted row indices (upper triangle only for `P`) and column
+  pointers already in the SCS integer dtype, plus the permutation that maps
+  the caller's `data` onto them. Instances built from a pattern seen before
+  share these arrays instead of re-sorting, re-extracting and re-converting
+  them, and the C layer reads them in place. It caches nothing of the SCS
+  setup itself: ordering and factorization still run for every instance.
+  Entries are keyed by a hash of the shape, index dtype and raw index
+  arrays, and evicted least-recently-used first once the total size
+  exceeds the limit. Disabled (limit 0) by default.
+  """
 
-    @param data     Dictionary containing keys `P`, `A`, `b`, `c`.
-    @param cone     Dictionary containing cone information.
-    @param settings Settings as kwargs, see docs.
+  def __init__(self):
+    self._lock = _thread.allocate_lock()
+    self._entries = collections.OrderedDict()
+    self._max_bytes = 0
+    self._bytes = 0
+    self._hits = 0
+    self._misses = 0
+    self._evictions = 0
 
-    Thread safety: construction is assumed to be thread-local. Calling
-    `__init__` on a live SCS instance from another thread (i.e. while
-    `solve` or `update` may be running on it) is undefined behavior.
-    Use a fresh `SCS(...)` instance instead.
-    """
-    self._settings = settings
-    if not data or not cone:
-      raise ValueError("Missing data or cone information")
+  def set_limit(self, max_bytes):
+    if max_bytes < 0:
+      raise ValueError("max_bytes must be nonnegative")
+    with self._lock:
+      self._max_bytes = int(max_bytes)
+      self._evict()
 
-    if "b" not in data or "c" not in data:
-      raise ValueError("Missing one of b, c from data dictionary")
-    if "A" not in data:
-      raise ValueError("Missing A from data dictionary")
+  def clear(self):
+    with self._lock:
+      self._entries.clear()
+      self._bytes = 0
+      self._hits = self._misses = self._evictions = 0
 
-    A = data["A"]
-    b = data["b"]
-    c = data["c"]
+  def stats(self):
+    with self._lock:
+      return {
+          "hits": self._hits,
+          "misses": self._misses,
+          "evictions": self._evictions,
+          "entries": len(self._entries),
+          "bytes": self._bytes,
+          "max_bytes": self._max_bytes,
+      }
 
-    if A is None or b is None or c is None:
-      raise ValueError("Incomplete data specification")
+  def enabled(self):
+    return self._max_bytes > 0
+
+  def _evict(self):
+    while self._bytes > self._max_bytes and self._entries:
+      _, entry = self._entries.popitem(last=False)
+      self._bytes -= sum(a.nbytes for a in entry if a is not None)
+      self._evictions += 1
+
+  def canonical(self, M, upper, int_dtype):
+    """Return `(data, indices, indptr)` of the canonical form of CSC `M`."""
+    if (not isinstance(M, _RawCSC) and M.has_sorted_indices
+        and not (upper and _has_lower_tri(M))
+        and M.indices.dtype == int_dtype and M.indptr.dtype == int_dtype):
+      # Already canonical and in the SCS dtype: hashing the pattern and
+      # permuting the data would cost more than there is to save.
+      return M.data, M.indices, M.indptr
+    import hashlib
+    h = hashlib.blake2b(digest_size=16)
+    h.update(repr((M.shape, upper, np.dtype(int_dtype).str,
+                   M.indices.dtype.str, M.indptr.dtype.str)).encode())
+    h.update(np.ascontiguousarray(M.indptr).data)
+    h.update(np.ascontiguousarray(M.indices).data)
+    key = h.digest()
+    with self._lock:
+      entry = self._entries.get(key)
+      if entry is not None:
+        self._entries.move_to_end(key)
+        self._hits += 1
+      else:
+        self._misses += 1
+    if entry is None:
+      entry = self._build(M, upper, int_dtype)
+      with self._lock:
+        if key not in self._entries:
+          self._entries[key] = entry
+          self._bytes += sum(a.nbytes for a in entry if a is not None)
+          self._evict()
+    indices, indptr, perm = entry
+    data = M.data if perm is None else M.data[perm]
+    return data, indices, indptr
+
+  @staticmethod
+  def _build(M, upper, int_dtype):
+    # Canonicalize the positions 0..nnz-1 along with the pattern, which
+    # yields the data permutation.
+    perm, indices, indptr = _canonical_csc(
+        np.arange(M.nnz), np.asarray(M.indices), np.asarray(M.indptr), upper)
+    if np.array_equal(perm, np.arange(M.nnz)):
+      perm = None
+    return (
+        np.ascontiguousarray(indices, dtype=int_dtype),
+        np.ascontiguousarray(indptr, dtype=int_dtype),
+        perm,
+    )
+
+
+_index_cache = _IndexCache()
+
+
+def set_index_cache_limit(max_bytes):
+  """Enable the canonical index cache with a size limit (0 disables it).
+
+  When enabled, instances whose `A` or `P` has a sparsity pattern seen
+  before in this process reuse its canonical (sorted, SCS-integer) index
+  arrays instead of recomputing and copying them. Matrices that are
+  already canonical bypass the cache. Only this Python-side work is saved;
+  the SCS setup (ordering and factorization) still runs per instance. The
+  cache keeps at most `max_bytes` of index data, evicting the least
+  recently used patterns first.
+  """
+  _index_cache.set_limit(max_bytes)
+
+
+def clear_index_cache():
+  """Drop every entry of the canonical index cache and reset its counters."""
+  _index_cache.clear()
+
+
+def index_cache_stats():
+  """Return a dict of canonical index cache counters.
+
+  Keys: 'hits', 'misses', 'evictions', 'entries', 'bytes', 'max_bytes'.
+  """
+  return _index_cache.stats()
 
-    if not sparse.issparse(A):
-      raise TypeError("A is required to be a sparse matrix")
-    if not A.format == "csc":
-      warnings.warn(
-          "Converting A to a CSC (compressed sparse column) matrix;"
-          " may take a while."
-      )
-      A = A.tocsc()
 
-    # .todense() returns a 2-D np.matrix; the C layer requires ndim==1.
-    # Flatten to a 1-D ndarray so a sparse b or c is actually accepted.
-    if sparse.issparse(b):
-      b = np.asarray(b.todense()).ravel()
+def _prepare_data(data, cone, int_dtype=None):
+  """Validate `data` and convert it to the CSC arrays the C layer expects.
 
-    if sparse.issparse(c):
-      c = np.asarray(c.todense()).ravel()
+  `A` and `P` are scipy sparse matrices or raw CSC `(data, indices,
+  indptr)` tuples, which need no scipy. Returns the positional arguments
+  `(shape, Ax, Ai, Ap, Px, Pi, Pp, b, c)` of the extension `SCS`
+  constructor (the cone is passed separately).
+  `int_dtype` is the integer dtype of the target extension; it is only
+  needed when the canonical index cache is enabled.
+  """
+  use_cache = int_dtype is not None and _index_cache.enabled()
+  if not data or not cone:
+    raise ValueError("Missing data or cone information")
 
-    m = len(b)
-    n = len(c)
+  if "b" not in data or "c" not in data:
+    raise ValueError("Missing one of b, c from data dictionary")
+  if "A" not in data:
+    raise ValueError("Missing A from data dictionary")
 
+  A = data["A"]
+  b = data["b"]
+  c = data["c"]
+
+  if A is None or b is None or c is None:
+    raise ValueError("Incomplete data specification")
+
+  if not (isinstance(A, tuple) or _issparse(A)):
+    raise TypeError("A is required to be a sparse matrix or a CSC tuple")
+  if not isinstance(A, tuple) and not A.format == "csc":
+    warnings.warn(
+        "Converting A to a CSC (compressed sparse column) matrix;"
+        " may take a while."
+    )
+    A = A.tocsc()
+
+  # .todense() returns a 2-D np.matrix; the C layer requires ndim==1.
+  # Flatten to a 1-D ndarray so a sparse b or c is actually accepted.
+  if _issparse(b):
+    b = np.asarray(b.todense()).ravel()
+
+  if _issparse(c):
+    c = np.asarray(c.todense()).ravel()
+
+  m = len(b)
+  n = len(c)
+
+  if isinstance(A, tuple):
+    A = _RawCSC.from_tuple(A, (m, n), "A")
+  if A.shape != (m, n):
+    raise ValueError("A shape not compatible with b,c")
+  if use_cache:
+    Adata, Aindices, Acolptr = _index_cache.canonical(A, False, int_dtype)
+  elif isinstance(A, _RawCSC):
+    Adata, Aindices, Acolptr = _canonical_csc(
+        A.data, A.indices, A.indptr, False)
+  else:
     # sorted_indices() returns a new matrix; sort_indices() would mutate
     # the caller's A in place (surprising, and a data race under the
     # free-threaded build if another thread reads the same matrix).
     if not A.has_sorted_indices:
       A = A.sorted_indices()
     Adata, Aindices, Acolptr = A.data, A.indices, A.indptr
-    if A.shape != (m, n):
-      raise ValueError("A shape not compatible with b,c")
-
-    Pdata, Pindices, Pcolptr = None, None, None
-    if "P" in data:
-      P = data["P"]
-      if P is not None:
-        if not sparse.issparse(P):
-          raise TypeError("P is required to be a sparse matrix")
-        if P.shape != (n, n):
-          raise ValueError("P shape not compatible with A,b,c")
-        if not P.format == "csc":
-          warnings.warn(
-              "Converting P to a CSC (compressed sparse column) "
-              "matrix; may take a while."
-          )
-          P = P.tocsc()
-        # sorted_indices() returns a new matrix; see A above.
-        if not P.has_sorted_indices:
-          P = P.sorted_indices()
-        # extract upper triangular component only
-        if _has_lower_tri(P):
-          P = sparse.triu(P, format="csc")
+
+  Pdata, Pindices, Pcolptr = None, None, None
+  if "P" in data:
+    P = data["P"]
+    if P is not None:
+      if isinstance(P, tuple):
+        P = _RawCSC.from_tuple(P, (n, n), "P")
+      elif not _issparse(P):
+        raise TypeError("P is required to be a sparse matrix or a CSC tuple")
+      if P.shape != (n, n):
+        raise ValueError("P shape not compatible with A,b,c")
+      if not isinstance(P, _RawCSC) and not P.format == "csc":
+        warnings.warn(
+            "Converting P to a CSC (compressed sparse column) "
+            "matrix; may take a while."
+        )
+        P = P.tocsc()
+      if use_cache:
+        Pdata, Pindices, Pcolptr = _index_cache.canonical(P, True, int_dtype)
+      elif isinstance(P, _RawCSC):
+        Pdata, Pindices, Pcolptr = _canonical_csc(
+            P.data, P.indices, P.indptr, True)
+      elif P.has_sorted_indices and not _has_lower_tri(P):
+        # Already sorted and upper triangular: use P's arrays as they are.
         Pdata, Pindices, Pcolptr = P.data, P.indices, P.indptr
+      else:
+        # Sort and extract the upper triangle without touching the caller's
+        # P. Unlike scipy's triu() this keeps duplicate entries as given,
+        # the same as the index cache and A.
+        Pdata, Pindices, Pcolptr = _canonical_csc(
+            P.data, P.indices, P.indptr, True)
+  return (m, n), Adata, Aindices, Acolptr, Pdata, Pindices, Pcolptr, b, c
+
+
+# save_problem()/load_problem() file layout, all little-endian:
+#   magic (8 bytes) | version (u32) | header length (u32) | JSON header
+#   | padding to _PROBLEM_ALIGN | arrays, each _PROBLEM_ALIGN-aligned.
+# The header holds the shape, cone, settings and, per array, its dtype,
+# length and offset from the start of the array section, so arrays can be
+# used in place from a read-only memory map.
+_PROBLEM_MAGIC = b"SCSPROB\0"
+_PROBLEM_VERSION = 1
+_PROBLEM_ALIGN = 64
+_PROBLEM_PREFIX = struct.Struct("<8sII")
+_PROBLEM_ARRAYS = ("Ax", "Ai", "Ap", "Px", "Pi", "Pp", "b", "c", "x", "y", "s")
+
+
+def _align(nbytes):
+  return -(-nbytes // _PROBLEM_ALIGN) * _PROBLEM_ALIGN
+
+
+def _to_json(v):
+  """Turn cone / settings values (numpy arrays and scalars) into JSON."""
+  if isinstance(v, dict):
+    return {k: _to_json(x) for k, x in v.items()}
+  if isinstance(v, (list, tuple, np.ndarray)):
+    return [_to_json(x) for x in v]
+  if isinstance(v, np.generic):
+    return v.item()
+  return v
+
+
+def _write_problem(path, shape, cone, settings, linear_solver, arrays):
+  import json
+  table, end = {}, 0
+  for name, arr in zip(_PROBLEM_ARRAYS, arrays):
+    if arr is None:
+      table[name] = None
+      continue
+    offset = _align(end)
+    table[name] = {
+        "dtype": arr.dtype.newbyteorder("<").str,
+        "len": arr.size,
+        "offset": offset,
+    }
+    end = offset + arr.nbytes
+  header = json.dumps({
+      "shape": list(shape),
+      "cone": _to_json(cone),
+      "settings": _to_json(settings),
+      "linear_solver": linear_solver,
+      "arrays": table,
+  }).encode("utf-8")
+  start = _align(_PROBLEM_PREFIX.size + len(header))
+  # Write next to the target and rename, so a reader never sees a torn file.
+  tmp = f"{path}.tmp{os.getpid()}.{_thread.get_ident()}"
+  try:
+    with open(tmp, "wb") as f:
+      f.write(_PROBLEM_PREFIX.pack(_PROBLEM_MAGIC, _PROBLEM_VERSION, len(header)))
+      f.write(header)
+      for name, arr in zip(_PROBLEM_ARRAYS, arrays):
+        if arr is None:
+          continue
+        f.seek(start + table[name]["offset"])
+        f.write(np.ascontiguousarray(arr, arr.dtype.newbyteorder("<")).data)
+      f.truncate(start + end)
+    os.replace(tmp, path)
+  except BaseException:
+    if os.path.exists(tmp):
+      os.remove(tmp)
+    raise
+
+
+def _read_problem(path):
+  """Map a save_problem() file; returns (header, dict of read-only arrays)."""
+  import mmap
+  with open(path, "rb") as f:
+    size = os.fstat(f.fileno()).st_size
+    if size < _PROBLEM_PREFIX.size:
+      raise ValueError(f"{path!r} is not an SCS problem file")
+    mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+  try:
+    return _map_problem(mm, path, size)
+  except BaseException:
+    # Only arrays that were returned may keep the map open.
+    mm.close()
+    raise
+
+
+def _map_problem(mm, path, size):
+  import json
+  magic, version, header_len = _PROBLEM_PREFIX.unpack_from(mm)
+  if magic != _PROBLEM_MAGIC:
+    raise ValueError(f"{path!r} is not an SCS problem file")
+  if version != _PROBLEM_VERSION:
+    raise ValueError(
+        f"SCS problem file version {version} is not supported (expected "
+        f"{_PROBLEM_VERSION})")
+  body = mm[_PROBLEM_PREFIX.size:_PROBLEM_PREFIX.size + header_len]
+  header = json.loads(body.decode("utf-8"))
+  start = _align(_PROBLEM_PREFIX.size + header_len)
+  specs = {}
+  for name in _PROBLEM_ARRAYS:
+    spec = header["arrays"][name]
+    if spec is not None:
+      dtype = np.dtype(spec["dtype"])
+      if start + spec["offset"] + spec["len"] * dtype.itemsize > size:
+        raise ValueError(f"SCS problem file {path!r} is truncated")
+      specs[name] = (dtype, spec["len"], start + spec["offset"])
+  # Views are only taken once the whole file has been checked, so a bad
+  # file leaves none behind and _read_problem can close the map. The
+  # arrays keep the map alive; it is closed once they are all gone.
+  arrays = dict.fromkeys(_PROBLEM_ARRAYS)
+  for name, (dtype, count, offset) in specs.items():
+    arrays[name] = np.frombuffer(mm, dtype=dtype, count=count, offset=offset)
+  return header, arrays
+
+
+class _DataFileReader(object):
+  """Sequential reader over a `write_data_filename` dump (the raw problem
+  SCS writes before solving). Arrays are returned as views into `buf`."""
+
+  def __init__(self, buf, path):
+    self._buf = buf
+    self._path = path
+    self._pos = 0
+    int_sz, float_sz, version_len = self._unpack("<III")
+    if int_sz not in (4, 8) or float_sz not in (4, 8):
+      raise ValueError(f"{path!r} is not an SCS data file")
+    self.int_dtype = np.dtype(f"<i{int_sz}")
+    self.float_dtype = np.dtype(f"<f{float_sz}")
+    self.version = bytes(self._take(version_len)).decode("ascii", "replace")
+
+  def _take(self, nbytes):
+    if nbytes < 0 or self._pos + nbytes > len(self._buf):
+      raise ValueError(f"SCS data file {self._path!r} is truncated or corrupt")
+    start, self._pos = self._pos, self._pos + nbytes
+    return memoryview(self._buf)[start:self._pos]
+
+  def _unpack(self, fmt):
+    return struct.unpack(fmt, self._take(struct.calcsize(fmt)))
+
+  def _array(self, dtype, count):
+    start = self._pos
+    self._take(count * dtype.itemsize)
+    return np.frombuffer(self._buf, dtype=dtype, count=count, offset=start)
+
+  def int(self):
+    return int(self._array(self.int_dtype, 1)[0])
+
+  def ints(self, count):
+    return self._array(self.int_dtype, count)
+
+  def floats(self, count):
+    return self._array(self.float_dtype, count)
+
+  def cone(self):
+    k = {"z": self.int(), "l": self.int()}
+    bsize = self.int()
+    if bsize > 0:
+      k["bl"] = self.floats(bsize - 1).tolist()
+      k["bu"] = self.floats(bsize - 1).tolist()
+    k["q"] = self.ints(self.int()).tolist()
+    k["s"] = self.ints(self.int()).tolist()
+    k["ep"] = self.int()
+    k["ed"] = self.int()
+    k["p"] = self.floats(self.int()).tolist()
+    return k, bsize
+
+  def matrix(self):
+    m, n = self.int(), self.int()
+    indptr = self.ints(n + 1)
+    nnz = int(indptr[-1]) if n >= 0 else -1
+    return (m, n), self.floats(nnz), self.ints(nnz), indptr
+
+
+def _read_data_file(path, use_mmap):
+  """Parse a `write_data_filename` dump into `SCS` constructor arguments."""
+  import mmap
+  with open(path, "rb") as f:
+    if use_mmap and os.fstat(f.fileno()).st_size > 0:
+      buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    else:
+      buf = f.read()
+  r = _DataFileReader(buf, path)
+  cone, bsize = r.cone()
+  m, n = r.int(), r.int()
+  b, c = r.floats(m), r.floats(n)
+  shape, Ax, Ai, Ap = r.matrix()
+  if shape != (m, n):
+    raise ValueError(f"SCS data file {path!r} is corrupt: A is {shape}, "
+                     f"expected {(m, n)}")
+  Px = Pi = Pp = None
+  if r.int():
+    shape, Px, Pi, Pp = r.matrix()
+    if shape != (n, n):
+      raise ValueError(f"SCS data file {path!r} is corrupt: P is {shape}, "
+                       f"expected {(n, n)}")
+  rows = (cone["z"] + cone["l"] + bsize + sum(cone["q"]) +
+          sum(d * (d + 1) // 2 for d in cone["s"]) +
+          3 * (cone["ep"] + cone["ed"] + len(cone["p"])))
+  if rows != m:
+    # The data writer records neither complex PSD nor spectral cones.
+    raise ValueError(
+        f"cones in SCS data file {path!r} cover {rows} rows but A has {m}; "
+        "the file may use cone types the data writer does not record")
+  return (m, n), Ax, Ai, Ap, Px, Pi, Pp, b, c, cone
+
+
+def _vector_entries(idx, val, name):
+  """`(idx, val)` arrays for `SCS.update`, with a scalar `val` broadcast to
+  every index, or `(None, None)` if `idx` is None."""
+  if idx is None:
+    if val is not None:
+      raise ValueError(f"{name}_val needs {name}_idx")
+    return None, None
+  if val is None:
+    raise ValueError(f"{name}_idx needs {name}_val")
+  idx = np.asarray(idx)
+  if idx.ndim == 0:
+    idx = idx.reshape(1)
+  val = np.asarray(val, dtype=np.float64)
+  if val.ndim == 0:
+    val = np.broadcast_to(val, idx.shape)
+  return idx, val
+
+
+_SolveFuture = None
+
+
+def _new_solve_future():
+  """A new `_SolveFuture`. The class is defined on first use, so that
+  `import scs` does not import concurrent.futures."""
+  global _SolveFuture
+  if _SolveFuture is None:
+    from concurrent import futures
+
+    class _SolveFuture(futures.Future):
+      """Future of an asynchronous solve whose `cancel` also stops the
+      solve once it is running."""
+
+      def __init__(self):
+        super().__init__()
+        # Polled by the solve once per iteration; nonzero stops it.
+        self._stop = bytearray(1)
+
+      def cancel(self):
+        """Cancel a solve that has not started, or ask a running one to
+        stop.
+
+        A running solve cannot be cancelled outright: it stops after its
+        current iteration and the future completes with that iterate
+        ('status_val' `scs.SIGINT`, finite residuals), which also stays as
+        the instance's next warm start. This returns False, as for any
+        running future.
+        """
+        if super().cancel():
+          return True
+        if not self.done():
+          self._stop[0] = 1
+        return False
+
+  return _SolveFuture()
+
+
+_async_lock = _thread.allocate_lock()
+_async_pool = None
+
+
+def _async_executor():
+  """The threads shared by all `SCS.solve_async` calls, created on first
+  use (one per CPU). `_async_lock` also guards each instance's queue of
+  pending async solves (`SCS._async_jobs`)."""
+  global _async_pool
+  from concurrent import futures
+  with _async_lock:
+    if _async_pool is None:
+      _async_pool = futures.ThreadPoolExecutor(
+          max_workers=os.cpu_count() or 1, thread_name_prefix="scs-async")
+    return _async_pool
+
+
+# Settings handled by this module rather than the extension, with defaults.
+_PY_SETTINGS = {
+    "callback": None,
+    "callback_interval": 1,
+    "trace_stride": 0,
+    "trace_max_len": 1000,
+}
+
+
+class Settings(object):
+  """Solver settings validated once, for reuse across `SCS` instances.
+
+  Takes the same keyword settings as `SCS` (including `linear_solver`).
+  The backend is resolved and the settings are parsed and range-checked
+  here, so `SCS(data, cone, settings=s)` skips that work. A `Settings` is
+  immutable and can be shared between threads.
+  """
 
+  def __init__(self, **settings):
+    py = {k: settings.pop(k, v) for k, v in _PY_SETTINGS.items()}
+    self._linear_solver = LinearSolver(
+        settings.get("linear_solver", LinearSolver.AUTO)).value
     # Which scs are we using (scs_direct, scs_indirect, ...)
-    _scs = _select_scs_module(self._settings)
+    self._scs = _select_scs_module(settings)
+    _check_num_threads(self._scs, settings)
+    self._parsed = self._scs.Settings(**settings)
+    # Read-only views: every instance built from this shares them.
+    self._py = types.MappingProxyType(py)
+    self._settings = types.MappingProxyType(settings)
+
+
+def _settings_arg(settings):
+  """Return the `Settings` passed as `settings=`, or one built from the
+  keyword settings."""
+  stgs = settings.pop("settings", None)
+  if stgs is None:
+    return Settings(**settings)
+  if settings:
+    raise TypeError("settings cannot be combined with keyword settings")
+  if not isinstance(stgs, Settings):
+    raise TypeError("settings must be a scs.Settings")
+  return stgs
+
+
+class ConeSpec(object):
+  """A cone dict parsed once, for reuse across `SCS` instances.
+
+  Pass it to `SCS` in place of the dict to skip re-parsing the cone. It is
+  parsed for `linear_solver` here (which validates it), and for any other
+  backend on first use with that backend. It keeps its own copy of the
+  dict, so changing the dict afterwards has no effect.
+  """
+
+  def __init__(self, cone, linear_solver=LinearSolver.AUTO):
+    # A private copy behind a read-only view, shared by every instance
+    # built from this spec.
+    import copy
+    self._cone = types.MappingProxyType(copy.deepcopy(dict(cone)))
+    self._parsed = {}
+    self._for(_select_scs_module({"linear_solver": linear_solver}))
+
+  def _for(self, _scs):
+    parsed = self._parsed.get(_scs)
+    if parsed is None:
+      parsed = self._parsed.setdefault(_scs,
+                                       _scs.ConeSpec(dict(self._cone)))
+    return parsed
+
+
+def _cone_dict(cone):
+  return cone._cone if isinstance(cone, ConeSpec) else cone
+
+
+def _run_async_job(solver):
+  """Run the oldest pending `solve_async` job of `solver` on this pool
+  thread, then hand the pool the next one, if any.
+
+  At most one job per instance is ever on the pool, so the pool's threads
+  never wait on an instance lock for one another: other instances' jobs
+  are queued in between an instance's consecutive solves."""
+  with _async_lock:
+    future, args = solver._async_jobs.popleft()
+  if future.set_running_or_notify_cancel():
+    try:
+      future.set_result(solver._solver.solve(*args, future._stop))
+    except BaseException as e:
+      future.set_exception(e)
+  with _async_lock:
+    if not solver._async_jobs:
+      solver._async_jobs = None
+      return
+  _async_executor().submit(_run_async_job, solver)
+
+
+class SCS(object):
+
+  # Pending solve_async jobs, oldest first, while one is on the pool;
+  # guarded by _async_lock.
+  _async_jobs = None
+
+  def __init__(self, data, cone, **settings):
+    """Initialize the SCS solver.
+
+    @param data     Dictionary containing keys `P`, `A`, `b`, `c`. `A` and
+                    `P` are scipy sparse matrices or `(data, indices,
+                    indptr)` tuples of CSC arrays.
+    @param cone     Dictionary containing cone information, or a `ConeSpec`.
+    @param settings Settings as kwargs, see docs, or `settings=` a
+                    `Settings` object.
+
+    Thread safety: construction is assumed to be thread-local. Calling
+    `__init__` on a live SCS instance from another thread (i.e. while
+    `solve` or `update` may be running on it) is undefined behavior.
+    Use a fresh `SCS(...)` instance instead.
+    """
+    self._setup(
+        cone, settings,
+        lambda _scs: _prepare_data(data, _cone_dict(cone), _int_dtype(_scs)))
+
+  def _setup(self, cone, settings, make_args):
+    """Create the extension solver; `make_args(module)` returns its data
+    arguments for the chosen extension module."""
+    stgs = _settings_arg(settings)
+    # Copies, so that one instance cannot change another's.
+    self._settings = dict(stgs._settings)
+    self._cone = dict(_cone_dict(cone))
+    self._linear_solver = stgs._linear_solver
+    _scs = stgs._scs
+    args = make_args(_scs)
+    if isinstance(cone, ConeSpec):
+      cone = cone._for(_scs)
 
     # Initialize solver
-    self._solver = _scs.SCS(
-        (m, n),
-        Adata,
-        Aindices,
-        Acolptr,
-        Pdata,
-        Pindices,
-        Pcolptr,
-        b,
-        c,
-        cone,
-        **self._settings,
-    )
+    self._solver = _scs.SCS(*args, cone, settings=stgs._parsed)
+    if stgs._py["callback"] is not None:
+      self._solver._set_callback(stgs._py["callback"],
+                                 stgs._py["callback_interval"])
+    if stgs._py["trace_stride"]:
+      self._solver._set_trace(stgs._py["trace_stride"],
+                              stgs._py["trace_max_len"])
 
-  def solve(self, warm_start=True, x=None, y=None, s=None):
+  def set_callback(self, callback, interval=1):
+    """Set the progress callback used by later solves (None removes it).
+
+    During a solve, `callback(stats)` is called every `interval`
+    iterations with a dict of the residuals of the latest iteration:
+    'iter', 'res_pri', 'res_dual', 'gap', 'pobj', 'dobj' and 'scale'. If
+    it returns a true value the solve stops after that iteration and
+    returns its iterate with finite residuals and info 'status_val'
+    `scs.SIGINT` (unless it converged in that iteration). Nothing is
+    printed, and the iterate is kept as the next solve's warm start. An
+    exception it raises stops the solve the same way and is raised by
+    `solve`. The GIL is only taken for these calls, so a
+    large `interval` keeps the overhead negligible. The same can be set at
+    construction with the `callback` and `callback_interval` settings.
+
+    The solve holds this instance while the callback runs, so the callback
+    must not call `solve`, `update`, `save_problem` or any other method of
+    the same instance: those raise RuntimeError (which then ends the
+    solve). Other instances can be used freely.
+
+    @param callback Callable taking one dict, or None.
+    @param interval Iterations between calls.
+    """
+    self._solver._set_callback(callback, interval)
+
+  def save_problem(self, path):
+    """Write this instance's problem and warm start to `path`.
+
+    The file is a dump of the problem data plus a warm start, not of the
+    SCS workspace: it holds `A`, `P`, `b` and `c` as they stand after any
+    `update`/`update_matrices` calls (canonicalized, in the SCS
+    integer/float types), the cone, the settings and the last solution.
+    `SCS.load_problem` builds a new instance from it with a full SCS setup.
+    Needs the `keep_problem=True` setting, without which the problem is
+    not kept after setup.
+
+    The file is written to a temporary file and renamed into place. The
+    format is versioned and meant to be read back with the same SCS
+    release; its arrays are aligned so they can be used straight from a
+    memory map.
+
+    @param path File name to write.
+    """
+    shape, *arrays = self._solver._problem_dump()
+    _write_problem(path, shape, self._cone, self._settings,
+                   self._linear_solver, arrays)
+
+  @classmethod
+  def load_problem(cls, path, **settings):
+    """Create an instance from a file written by `save_problem`.
+
+    The problem data are memory-mapped and handed to SCS without parsing
+    or copies, and the saved solution becomes the warm-start of the first
+    solve. This runs a full SCS setup (scaling and factorization), exactly
+    like `SCS(...)` on the same data; only the Python-side parsing is
+    skipped. The saved settings include `keep_problem=True`, so the new
+    instance can be saved again.
+
+    @param path     File written by `save_problem`.
+    @param settings Settings overriding the saved ones.
+
+    @return SCS instance ready to `solve()`.
+    """
+    header, arrays = _read_problem(path)
+    stgs = header["settings"]
+    stgs.update(settings)
+    stgs.setdefault("linear_solver", header["linear_solver"])
+    args = (tuple(header["shape"]),) + tuple(
+        arrays[name] for name in _PROBLEM_ARRAYS[:8])
+    self = cls.__new__(cls)
+    self._setup(header["cone"], stgs, lambda _scs: args)
+    self._solver._set_warm_start(arrays["x"], arrays["y"], arrays["s"])
+    return self
+
+  @classmethod
+  def from_file(cls, path, mmap=True, **settings):
+    """Create an instance from a file written by the `write_data_filename`
+    setting.
+
+    With `mmap=True` the file is memory-mapped and the problem arrays are
+    views into the mapping, so large archived problems are paged in
+    rather than read and parsed in Python. Arrays whose layout already
+    matches SCS are used in place; the others are copied once, straight
+    from the mapping (see `converted_inputs`).
+
+    Complex PSD and spectral cones are not recorded in these files; a
+    file whose cones do not cover all rows of `A` is rejected.
+
+    @param path     File written via `write_data_filename`.
+    @param mmap     Memory-map the file (True) or read it into memory.
+    @param settings Settings as kwargs, see docs. The file's own settings
+                    are not used.
+
+    @return SCS instance ready to `solve()`.
+    """
+    *args, cone = _read_data_file(path, mmap)
+    self = cls.__new__(cls)
+    self._setup(cone, settings, lambda _scs: args)
+    return self
+
+  @property
+  def converted_inputs(self):
+    """Names of the inputs ('Ax', 'Ai', ..., 'b', 'c') that had to be copied
+    during setup because their dtype, alignment or memory layout did not
+    match what SCS uses. The others were read in place without a conversion;
+    to get there, pass C-contiguous float64 data and index arrays whose
+    dtype matches `scs.__sizeof_int__`. With `keep_problem`, matrix arrays
+    read in place are still copied once afterwards, for the kept problem
+    (see `update_matrices`).
+    """
+    return self._solver.converted_inputs
+
+  def solve(self, warm_start=True, x=None, y=None, s=None, out_x=None,
+            out_y=None, out_s=None, lite_info=False):
     """Solve the optimization problem.
 
     @param warm_start   Whether to warm-start. By default the solution of
@@ -193,25 +983,435 @@ class SCS(object):
     @param x            Primal warm-start override.
     @param y            Dual warm-start override.
     @param s            Slack warm-start override.
+    @param out_x        Optional preallocated array the primal solution is
+                        written into (and returned as 'x'). Must be a
+                        writeable, C-contiguous, native-byte-order float64
+                        array of length n.
+    @param out_y        As `out_x`, for the dual solution (length m).
+    @param out_s        As `out_x`, for the primal slack (length m). The out
+                        arrays must not share memory with each other.
+    @param lite_info    If True, 'info' only holds 'status', 'status_val',
+                        'iter', 'pobj', 'dobj', 'res_pri', 'res_dual', 'gap'
+                        and 'solve_time', which is cheaper to build.
 
     @return dictionary with solution with keys:
          'x' - primal solution
          's' - primal slack solution
          'y' - dual solution
-         'info' - information dictionary (see docs)
+         'info' - information dictionary (see docs). With the
+                  `trace_stride` setting, 'info' also has a 'trace':
+                  a structured array with fields 'iter', 'res_pri',
+                  'res_dual', 'gap', 'pobj', 'dobj' and 'scale', one
+                  record every `trace_stride` iterations plus the final
+                  one, keeping the last `trace_max_len` (default 1000).
+                  The CG backends (CPU_INDIRECT, GPU_INDIRECT) also add
+                  'lin_sys_iters': the 'total', 'max' and 'mean' CG
+                  iterations per ADMM iteration of this solve, and 'hist',
+                  the ADMM iteration count by CG iterations (bin 0: none,
+                  bin k: [2**(k-1), 2**k)).
+    """
+    return self._solver.solve(warm_start, x, y, s, out_x, out_y, out_s,
+                              lite_info)
+
+  def solve_async(self, warm_start=True, x=None, y=None, s=None,
+                  out_x=None, out_y=None, out_s=None, lite_info=False):
+    """Start `solve` on a shared worker thread and return a future for it.
+
+    The arguments and the future's result are those of `solve`. Solves
+    run on a pool of one thread per CPU shared by all instances, with the
+    GIL released, so one thread (e.g. an asyncio event loop, via
+    `await asyncio.wrap_future(solver.solve_async())`) can drive many
+    solves without a thread of its own per solve. Async solves of one
+    instance are queued and run one at a time, in submission order, on at
+    most one pool thread, so a long queue on one instance does not hold up
+    the others. A synchronous `solve` of the same instance from another
+    thread still makes the pool thread wait for it.
+
+    `future.cancel()` drops a solve that has not started yet; a running
+    solve instead stops after its current iteration and completes with
+    that iterate ('info' 'status_val' is `scs.SIGINT`). As with a callback
+    stop, nothing is printed and the iterate is kept as the next warm
+    start. Cancelling the asyncio wrapper does the same.
+
+    @return `concurrent.futures.Future` of the solution dictionary.
     """
-    return self._solver.solve(warm_start, x, y, s)
+    future = _new_solve_future()
+    job = (future, (warm_start, x, y, s, out_x, out_y, out_s, lite_info))
+    with _async_lock:
+      if self._async_jobs is not None:
+        self._async_jobs.append(job)
+        return future
+      self._async_jobs = collections.deque([job])
+    _async_executor().submit(_run_async_job, self)
+    return future
 
-  def update(self, b=None, c=None):
+  def update(self, b=None, c=None, b_idx=None, b_val=None, c_idx=None,
+             c_val=None):
     """Update the `b` vector, `c` vector, or both, before another solve.
 
     After a solve we can reuse the SCS workspace in another solve if the
     only problem data that has changed are the `b` and `c` vectors.
 
-    @param  b   New `b` vector.
-    @param  c   New `c` vector.
+    Instead of a whole vector, a few entries can be changed with
+    `b_idx`/`b_val` (or `c_idx`/`c_val`): `b[b_idx] = b_val`, applied to
+    `b` as of the last update. This avoids building and converting a full
+    vector when only a few entries change.
+
+    The first partial update of `b` (or `c`) copies the current vector out
+    of the SCS workspace into a scratch vector kept by the instance; later
+    partial updates change that in place, and a whole-vector update drops
+    it. Either way SCS itself copies and rescales the whole of each vector
+    it is given, so an update costs O(m + n) in the core even when it
+    changes a single entry; what is saved is the Python-side work. An
+    update that mixes the two forms (e.g. `b` with `c_idx`/`c_val`) is
+    checked in full before any of it is applied.
+
+    @param  b       New `b` vector.
+    @param  c       New `c` vector.
+    @param  b_idx   Indices of the entries of `b` to change.
+    @param  b_val   Their new values (or one value for all of them).
+    @param  c_idx   Indices of the entries of `c` to change.
+    @param  c_val   Their new values (or one value for all of them).
+    """
+    if b_idx is None and c_idx is None:
+      if b_val is not None or c_val is not None:
+        raise ValueError("b_val/c_val need b_idx/c_idx")
+      self._solver.update(b, c)
+      return
+    if (b is not None and b_idx is not None) or (
+        c is not None and c_idx is not None):
+      raise ValueError("pass either a whole vector or indices and values, "
+                       "not both")
+    b_idx, b_val = _vector_entries(b_idx, b_val, "b")
+    c_idx, c_val = _vector_entries(c_idx, c_val, "c")
+    # A whole vector goes in the same call (as the values without indices),
+    # which checks everything before changing anything.
+    self._solver._update_entries(b_idx, b if b_idx is None else b_val,
+                                 c_idx, c if c_idx is None else c_val)
+
+  def update_matrices(self, Ax=None, Px=None):
+    """Update the nonzero values of `A`, `P`, or both, keeping the pattern.
+
+    The arrays hold the new values of the stored nonzeros, in the order of
+    the CSC matrices SCS was set up with, i.e. `A.data` / `P.data` of a
+    matrix with the same sparsity pattern, sorted indices and (for `P`)
+    only the upper triangle. The workspace is rebuilt from the retained
+    pattern, `b`, `c`, cone and settings, skipping all input validation,
+    conversion and cone parsing; the last solution is kept as the
+    warm-start for the next solve. Needs the `keep_problem` setting, which
+    keeps the problem after setup (otherwise it is freed once the workspace
+    is built).
+
+    This is not a cheap in-place update. SCS has no numeric-only
+    refactorization, so this runs the full SCS setup (scaling and a new
+    factorization) and costs about as much as constructing a new `SCS`.
+
+    With `keep_problem` the instance keeps its own copies of the setup
+    matrices (index arrays included) and of the arrays passed here, so the
+    caller's arrays can be changed or reused freely afterwards. Arrays
+    that setup did not already have to convert are copied for this, which
+    can cost one more copy of `A` and `P` in memory.
+
+    @param  Ax  New values for the nonzeros of `A`.
+    @param  Px  New values for the nonzeros of `P`.
+    """
+    self._solver.update_matrices(Ax, Px)
+
+  def solve_batch(self, b=None, c=None, warm_start=True):
+    """Solve a batch of problems that differ only in their `b` and `c`.
+
+    Row `i` of `b` and `c` defines solve `i`. All solves reuse this
+    workspace (and its factorization) in a single call that holds the
+    instance lock once and releases the GIL throughout. Afterwards the
+    workspace holds the last row's `b` and `c`, exactly as if `update` and
+    `solve` had been called once per row.
+
+    If the progress callback stops a solve (see `set_callback`), the batch
+    ends there: that row reports `scs.SIGINT` with its last iterate, and
+    the rows after it are not run. Their `x`, `y` and `s` are NaN and
+    their info records are all zero ('status_val' `scs.UNFINISHED`,
+    'iter' 0). The workspace then holds the stopped row's `b` and `c`.
+
+    @param b          2-D array of shape (k, m), or None to keep `b`.
+    @param c          2-D array of shape (k, n), or None to keep `c`.
+    @param warm_start Whether each solve warm-starts from the previous one
+                      (the first from the last solution of this instance).
+
+    @return dictionary with keys:
+         'x' - (k, n) array of primal solutions
+         'y' - (k, m) array of dual solutions
+         's' - (k, m) array of primal slacks
+         'info' - structured array of length k with one record per solve
+                  (same numeric fields as the `solve` info dictionary)
     """
-    self._solver.update(b, c)
+    return self._solver.solve_batch(b, c, warm_start)
+
+
+class ProblemTemplate(object):
+
+  def __init__(self, A_pattern, P_pattern, cone, *, shape=None, **settings):
+    """Compile a problem structure once for many numeric instances.
+
+    Everything that depends only on the structure is done here: the
+    backend and settings are resolved (see `Settings`), the cone is parsed
+    (see `ConeSpec`), and the sparsity patterns are canonicalized into the
+    sorted, upper-triangular-`P`, SCS-integer index arrays, together with
+    the permutation that maps values given in pattern order onto them.
+    `instantiate` then only permutes the values, in O(nnz). The SCS setup
+    itself (scaling and factorization) still runs per instance.
+
+    @param A_pattern CSC matrix whose sparsity pattern `A` has, or a
+                     `(data, indices, indptr)` tuple of CSC arrays; its
+                     values are ignored.
+    @param P_pattern Same for `P` (both triangles or the upper one), or
+                     None for an LP.
+    @param cone      Dictionary containing cone information, or a
+                     `ConeSpec`.
+    @param shape     `(m, n)` of `A`; required when `A_pattern` is a
+                     tuple, which does not carry its number of rows.
+    @param settings  Settings as kwargs, see docs, or `settings=` a
+                     `Settings` object.
+    """
+    self._settings = _settings_arg(settings)
+    _scs = self._settings._scs
+    int_dtype = _int_dtype(_scs)
+    if isinstance(A_pattern, tuple):
+      if shape is None:
+        raise ValueError("shape is required when A_pattern is a tuple")
+      A_pattern = _RawCSC.from_tuple(A_pattern, tuple(shape), "A_pattern")
+    elif not _issparse(A_pattern) or A_pattern.format != "csc":
+      raise TypeError("A_pattern is required to be a CSC matrix or a CSC "
+                      "tuple")
+    elif shape is not None and tuple(shape) != A_pattern.shape:
+      raise ValueError("shape does not match A_pattern")
+    self._shape = A_pattern.shape
+    self._A = _IndexCache._build(A_pattern, False, int_dtype)
+    self._A_nnz = A_pattern.nnz
+    self._P = None
+    if P_pattern is not None:
+      n = self._shape[1]
+      if isinstance(P_pattern, tuple):
+        P_pattern = _RawCSC.from_tuple(P_pattern, (n, n), "P_pattern")
+      elif not _issparse(P_pattern) or P_pattern.format != "csc":
+        raise TypeError("P_pattern is required to be a CSC matrix or a CSC "
+                        "tuple")
+      if P_pattern.shape != (n, n):
+        raise ValueError("P_pattern shape not compatible with A_pattern")
+      self._P = _IndexCache._build(P_pattern, True, int_dtype)
+      self._P_nnz = P_pattern.nnz
+    if not isinstance(cone, ConeSpec):
+      cone = ConeSpec(cone, self._settings._linear_solver)
+    self._cone = cone
+
+  @staticmethod
+  def _values(x, pattern, nnz, name):
+    x = np.asarray(x, dtype=np.float64)
+    if x.shape != (nnz,):
+      raise ValueError(f"{name} must have one value per pattern entry ({nnz})")
+    perm = pattern[2]
+    return x if perm is None else x[perm]
+
+  def instantiate(self, Ax, Px, b, c):
+    """Create a solver for this structure with the given values.
+
+    @param Ax Values of `A`, in the order of the `A_pattern` data.
+    @param Px Values of `P`, in the order of the `P_pattern` data (None
+              when the template has no `P`).
+    @param b  Vector of length `m`.
+    @param c  Vector of length `n`.
+
+    @return SCS instance ready to `solve()`.
+    """
+    m, n = self._shape
+    b = np.asarray(b, dtype=np.float64)
+    c = np.asarray(c, dtype=np.float64)
+    if b.shape != (m,) or c.shape != (n,):
+      raise ValueError("b, c not compatible with A_pattern shape")
+    Ai, Ap = self._A[0], self._A[1]
+    Pi = Pp = None
+    if self._P is None:
+      if Px is not None:
+        raise ValueError("Px given for a template without P")
+    else:
+      if Px is None:
+        raise ValueError("Px is required by this template")
+      Px = self._values(Px, self._P, self._P_nnz, "Px")
+      Pi, Pp = self._P[0], self._P[1]
+    args = ((m, n), self._values(Ax, self._A, self._A_nnz, "Ax"), Ai, Ap,
+            Px, Pi, Pp, b, c)
+    solver = SCS.__new__(SCS)
+    solver._setup(self._cone, {"settings": self._settings}, lambda _scs: args)
+    return solver
+
+
+def _stop_pool_workers(jobs, workers):
+  for _ in range(workers):
+    jobs.put(None)
+
+
+def _fail_pool_jobs(jobs):
+  """Fail the futures of the jobs left in a closed pool's queue."""
+  import queue
+  while True:
+    try:
+      job = jobs.get_nowait()
+    except queue.Empty:
+      return
+    if job is not None and job[0].set_running_or_notify_cancel():
+      job[0].set_exception(RuntimeError("SCSPool closed before the job ran"))
+
+
+class SCSPool(object):
+
+  def __init__(self, data, cone, workers=None, **settings):
+    """Initialize a pool of SCS workers sharing one problem structure.
+
+    Each worker thread owns a private SCS workspace for the same `A`, `P`
+    and cone, and repeatedly takes `(b, c, warm-start)` jobs off a shared
+    queue. Idle workers pull the next job as soon as they finish, so slow
+    jobs never hold up the others. Solves release the GIL, so the workers
+    run in parallel on separate cores.
+
+    The data is validated and converted once. The SCS core cannot clone a
+    workspace, though, so each worker runs the full C-level setup
+    (`scs_init`: scaling, ordering and factorization) for itself. These
+    setups run concurrently, but the pool costs about as much setup time
+    and memory as `workers` separate `SCS` instances.
+
+    @param data     Dictionary containing keys `P`, `A`, `b`, `c`.
+    @param cone     Dictionary containing cone information, or a `ConeSpec`.
+    @param workers  Number of worker threads (default: `os.cpu_count()`).
+    @param settings Settings as kwargs, see docs, or `settings=` a
+                    `Settings` object. Callbacks and traces are not
+                    supported.
+    """
+    import queue
+    import threading
+    import weakref
+    from concurrent import futures
+    if workers is None:
+      workers = os.cpu_count() or 1
+    if workers < 1:
+      raise ValueError("workers must be a positive integer")
+    stgs = _settings_arg(settings)
+    if stgs._py["callback"] is not None or stgs._py["trace_stride"]:
+      raise TypeError("SCSPool does not support callbacks or traces")
+    _scs = stgs._scs
+    args = _prepare_data(data, _cone_dict(cone), _int_dtype(_scs))
+    if isinstance(cone, ConeSpec):
+      cone = cone._for(_scs)
+
+    self._jobs = queue.SimpleQueue()
+    # Guards _closed, so no job is queued behind the stop sentinels.
+    self._lock = threading.Lock()
+    self._closed = False
+    self._threads = []
+    # The workers hold no reference to the pool, so a pool that is never
+    # closed can still be collected; this then stops its workers.
+    self._finalizer = weakref.finalize(self, _stop_pool_workers, self._jobs,
+                                       workers)
+    ready = [futures.Future() for _ in range(workers)]
+    for i in range(workers):
+      t = threading.Thread(
+          target=self._worker,
+          args=(self._jobs, _scs, args, cone, stgs._parsed, ready[i]),
+          name=f"scs-pool-{i}",
+          daemon=True,
+      )
+      t.start()
+      self._threads.append(t)
+    try:
+      for f in ready:
+        f.result()
+    except BaseException:
+      self.close()
+      raise
+
+  @property
+  def workers(self):
+    """Number of worker threads in the pool."""
+    return len(self._threads)
+
+  @staticmethod
+  def _worker(jobs, _scs, args, cone, settings, ready):
+    # Jobs are solved relative to the original b/c, so a job that only
+    # sets one of them does not inherit the other from a previous job.
+    b0, c0 = args[-2], args[-1]
+    try:
+      solver = _scs.SCS(*args, cone, settings=settings)
+    except BaseException as e:
+      ready.set_exception(e)
+      return
+    ready.set_result(None)
+    while True:
+      job = jobs.get()
+      if job is None:
+        return
+      future, b, c, warm_start, x, y, s = job
+      if not future.set_running_or_notify_cancel():
+        continue
+      try:
+        solver.update(b0 if b is None else b, c0 if c is None else c)
+        future.set_result(solver.solve(warm_start, x, y, s, None, None, None,
+                                       False, future._stop))
+      except BaseException as e:
+        future.set_exception(e)
+
+  def submit(self, b=None, c=None, warm_start=True, x=None, y=None, s=None):
+    """Queue one solve and return a `concurrent.futures.Future` for it.
+
+    `b` and `c` default to the vectors the pool was built with. Warm-starts
+    come from whichever solve the chosen worker ran last, unless overridden
+    by `x`, `y`, `s` (or disabled with `warm_start=False`). Cancelling the
+    future stops the job at its next iteration if it is already running,
+    as for `SCS.solve_async`.
+
+    @return future whose result is the same dictionary as `SCS.solve`.
+    """
+    future = _new_solve_future()
+    with self._lock:
+      if self._closed:
+        raise RuntimeError("cannot submit to a closed SCSPool")
+      self._jobs.put((future, b, c, warm_start, x, y, s))
+    return future
+
+  def solve_many(self, jobs):
+    """Solve many jobs, yielding results in the order they finish.
+
+    @param jobs Iterable of dicts of `submit` keyword arguments.
+
+    @return generator of `(index, solution)` pairs, where `index` is the
+            position of the job in `jobs`.
+    """
+    from concurrent import futures
+    pending = {}
+    for i, job in enumerate(jobs):
+      pending[self.submit(**job)] = i
+    for future in futures.as_completed(pending):
+      yield pending[future], future.result()
+
+  def close(self, wait=True):
+    """Stop the workers once the queued jobs have been solved.
+
+    With `wait`, also wait for the workers to exit, and fail the future of
+    any job they left behind.
+    """
+    with self._lock:
+      if self._closed:
+        return
+      self._closed = True
+      self._finalizer()
+    if wait:
+      for t in self._threads:
+        t.join()
+      _fail_pool_jobs(self._jobs)
+
+  def __enter__(self):
+    return self
+
+  def __exit__(self, *exc):
+    self.close()
+    return False
 
 
 # Backwards compatible helper function that simply calls the main API.
@@ -13,12 +13,22 @@ static PyObject *sizeof_float(PyObject *self) {
   return Py_BuildValue("n", sizeof(scs_float));
 }
 
+static PyObject *has_openmp(PyObject *self) {
+#ifdef _OPENMP
+  Py_RETURN_TRUE;
+#else
+  Py_RETURN_FALSE;
+#endif
+}
+
 static PyMethodDef scs_module_methods[] = {
     {"version", (PyCFunction)version, METH_NOARGS, "Version number for SCS."},
     {"sizeof_int", (PyCFunction)sizeof_int, METH_NOARGS,
      "Int size (in bytes) SCS uses."},
     {"sizeof_float", (PyCFunction)sizeof_float, METH_NOARGS,
      "Float size (in bytes) SCS uses."},
+    {"has_openmp", (PyCFunction)has_openmp, METH_NOARGS,
+     "Whether SCS was built with OpenMP (the num_threads setting)."},
     {NULL, NULL} /* sentinel */
 };
 
@@ -68,6 +78,9 @@ static PyObject *moduleinit(void) {
   PyUnstable_Module_SetGIL(m, Py_MOD_GIL_NOT_USED);
 #endif
 
+  if (scs_py_progress_init() < 0)
+    return NULL;
+
   /* Initialize SCS_Type */
   SCS_Type.tp_new = PyType_GenericNew;
   if (PyType_Ready(&SCS_Type) < 0)
@@ -78,6 +91,17 @@ static PyObject *moduleinit(void) {
   if (PyModule_AddObject(m, "SCS", (PyObject *)&SCS_Type) < 0)
     return NULL;
 
+  /* Parsed settings and cones, reusable across SCS constructions */
+  if (PyType_Ready(&ScsPySettings_Type) < 0 ||
+      PyType_Ready(&ScsPyConeSpec_Type) < 0)
+    return NULL;
+  Py_INCREF(&ScsPySettings_Type);
+  if (PyModule_AddObject(m, "Settings", (PyObject *)&ScsPySettings_Type) < 0)
+    return NULL;
+  Py_INCREF(&ScsPyConeSpec_Type);
+  if (PyModule_AddObject(m, "ConeSpec", (PyObject *)&ScsPyConeSpec_Type) < 0)
+    return NULL;
+
   return m;
 };
 
@@ -3,15 +3,6 @@
 #ifndef PY_SCSOBJECT_H
 #define PY_SCSOBJECT_H
 
-/* SCS Object type */
-typedef struct {
-  PyObject_HEAD
-  ScsWork *work; /* Workspace */
-  ScsSolution *sol;            /* Solution, keep around for warm-starts */
-  scs_int m, n;
-  PyThread_type_lock lock;     /* Per-instance lock protecting work/sol */
-} SCS;
-
 /* Just a helper struct to store the PyArrayObjects that need Py_DECREF */
 struct ScsPyData {
   PyArrayObject *Ax;
@@ -24,6 +15,35 @@ struct ScsPyData {
   PyArrayObject *c;
 };
 
+/* SCS Object type */
+typedef struct {
+  PyObject_HEAD
+  ScsWork *work; /* Workspace */
+  ScsSolution *sol;            /* Solution, keep around for warm-starts */
+  scs_int m, n;
+  PyThread_type_lock lock;     /* Per-instance lock protecting work/sol */
+  PyObject *converted_inputs;  /* Names of inputs copied during SCS_init */
+  PyObject *callback;          /* Progress callback or NULL (under lock) */
+  scs_int callback_interval;   /* Iterations between callback calls */
+  scs_int trace_stride;        /* Iterations between trace samples, 0: off */
+  scs_int trace_cap;           /* Max trace samples kept per solve */
+  scs_int num_threads;         /* OpenMP threads for setup/solves, 0: default */
+  /* Problem as passed to scs_init, kept (under lock) with the keep_problem
+   * setting only, so the workspace can be rebuilt with new matrix values
+   * without re-parsing anything, and saved. ps owns the arrays d points
+   * into, except b and c, which d does not use: the current ones are the
+   * workspace's (scs_py_work_b/c). NULL without keep_problem. */
+  ScsData *d;
+  ScsCone *k;
+  ScsSettings *stgs;
+  struct ScsPyData ps;
+  /* Scratch copies of the current b and c (under lock) for partial updates,
+   * which change them in place and pass them to scs_update. Each is made
+   * from the workspace's own copy on the first partial update of that
+   * vector, and dropped (NULL) when the vector is replaced whole. */
+  PyArrayObject *b, *c;
+} SCS;
+
 /* Note, Python3.x may require special handling for the scs_int and scs_float
  * types. */
 static int scs_get_int_type(void) {
@@ -55,16 +75,19 @@ static int scs_get_float_type(void) {
 }
 
 /* Returns a new strong reference (caller must Py_DECREF), or NULL with a
- * Python exception set on failure (OOM or cast error). The overhead is
- * small unless the input array has been reordered or its dtype differs. */
+ * Python exception set on failure (OOM or cast error). An input that is
+ * already an aligned, C-contiguous array of the requested type is returned
+ * as-is (a new reference to the same object, no copy); anything else is
+ * converted into a fresh array, with the same unchecked casting as
+ * PyArray_Cast. Callers can tell the two apart by comparing pointers. */
 static PyArrayObject *scs_get_contiguous(PyArrayObject *array, int typenum) {
-  PyArrayObject *tmp_arr = PyArray_GETCONTIGUOUS(array);
-  if (!tmp_arr) {
+  PyArray_Descr *descr = PyArray_DescrFromType(typenum);
+  if (!descr) {
     return NULL;
   }
-  PyArrayObject *new_owner = (PyArrayObject *)PyArray_Cast(tmp_arr, typenum);
-  Py_DECREF(tmp_arr);
-  return new_owner;  /* NULL on Cast failure; exception already set */
+  /* PyArray_FromArray steals the reference to descr */
+  return (PyArrayObject *)PyArray_FromArray(
+      array, descr, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
 }
 
 /* Set a Python exception describing a cone-field parsing failure, then
@@ -325,6 +348,48 @@ static int get_cone_float_arr(char *key, scs_float **varr, scs_int *vsize,
   return 0;
 }
 
+/* Free the arrays of a parsed cone (see parse_cone), not k itself. */
+static void free_cone_arrays(ScsCone *k) {
+  if (k->bu) {
+    scs_free(k->bu);
+  }
+  if (k->bl) {
+    scs_free(k->bl);
+  }
+  if (k->q) {
+    scs_free(k->q);
+  }
+  if (k->s) {
+    scs_free(k->s);
+  }
+  if (k->cs) {
+    scs_free(k->cs);
+  }
+  if (k->p) {
+    scs_free(k->p);
+  }
+#ifdef USE_SPECTRAL_CONES
+  if (k->d) {
+    scs_free(k->d);
+  }
+  if (k->nuc_m) {
+    scs_free(k->nuc_m);
+  }
+  if (k->nuc_n) {
+    scs_free(k->nuc_n);
+  }
+  if (k->ell1) {
+    scs_free(k->ell1);
+  }
+  if (k->sl_n) {
+    scs_free(k->sl_n);
+  }
+  if (k->sl_k) {
+    scs_free(k->sl_k);
+  }
+#endif
+}
+
 static void free_py_scs_data(ScsData *d, ScsCone *k, ScsSettings *stgs,
                              struct ScsPyData *ps) {
   if (ps->Ax) {
@@ -352,44 +417,7 @@ static void free_py_scs_data(ScsData *d, ScsCone *k, ScsSettings *stgs,
     Py_DECREF(ps->c);
   }
   if (k) {
-    if (k->bu) {
-      scs_free(k->bu);
-    }
-    if (k->bl) {
-      scs_free(k->bl);
-    }
-    if (k->q) {
-      scs_free(k->q);
-    }
-    if (k->s) {
-      scs_free(k->s);
-    }
-    if (k->cs) {
-      scs_free(k->cs);
-    }
-    if (k->p) {
-      scs_free(k->p);
-    }
-#ifdef USE_SPECTRAL_CONES
-    if (k->d) {
-      scs_free(k->d);
-    }
-    if (k->nuc_m) {
-      scs_free(k->nuc_m);
-    }
-    if (k->nuc_n) {
-      scs_free(k->nuc_n);
-    }
-    if (k->ell1) {
-      scs_free(k->ell1);
-    }
-    if (k->sl_n) {
-      scs_free(k->sl_n);
-    }
-    if (k->sl_k) {
-      scs_free(k->sl_k);
-    }
-#endif
+    free_cone_arrays(k);
     scs_free(k);
   }
   if (d) {
@@ -406,6 +434,24 @@ static void free_py_scs_data(ScsData *d, ScsCone *k, ScsSettings *stgs,
   }
 }
 
+/* Append name to the list of converted inputs if ingesting `in` needed a
+ * copy, i.e. scs_get_contiguous returned a different array. */
+static int record_conversion(PyObject *converted, PyArrayObject *in,
+                             PyArrayObject *out, const char *name) {
+  int rc;
+  PyObject *py_name;
+  if (in == out) {
+    return 0;
+  }
+  py_name = PyUnicode_FromString(name);
+  if (!py_name) {
+    return -1;
+  }
+  rc = PyList_Append(converted, py_name);
+  Py_DECREF(py_name);
+  return rc;
+}
+
 /* The finish_with_* / none_with_* helpers do NOT clobber a pending
  * exception. This matters when a lower-level helper (e.g. a cone parser
  * or scs_get_contiguous) has already set a specific TypeError or
@@ -439,284 +485,173 @@ static PyObject *none_with_type_error(char *str) {
   return (PyObject *)NULL;
 }
 
-static int SCS_init(SCS *self, PyObject *args, PyObject *kwargs) {
-  /* data structures for arguments */
-  PyArrayObject *Ax, *Ai, *Ap, *Px, *Pi, *Pp, *c, *b;
-  PyObject *cone;
-  PyObject *verbose = NULL;
-  PyObject *normalize = NULL;
-  PyObject *adaptive_scale = NULL;
-  /* get the typenum for the primitive scs_int and scs_float types */
-  int scs_int_type = scs_get_int_type();
-  int scs_float_type = scs_get_float_type();
-  scs_int bsizeu, bsizel, f_tmp;
-  struct ScsPyData ps = {0};
-  /* scs data structures */
-  ScsData *d = (ScsData *)scs_calloc(1, sizeof(ScsData));
-  ScsCone *k = (ScsCone *)scs_calloc(1, sizeof(ScsCone));
-  ScsSettings *stgs = (ScsSettings *)scs_calloc(1, sizeof(ScsSettings));
-  if (!d || !k || !stgs) {
-    scs_free(d);
-    scs_free(k);
-    scs_free(stgs);
+/* Duplicate a settings filename so it outlives the kwargs it came from. */
+static int dup_settings_str(const char **str) {
+  char *copy;
+  if (!*str) {
+    return 0;
+  }
+  copy = (char *)scs_malloc(strlen(*str) + 1);
+  if (!copy) {
+    *str = NULL;
     PyErr_NoMemory();
     return -1;
   }
+  strcpy(copy, *str);
+  *str = copy;
+  return 0;
+}
 
-  ScsMatrix *A, *P;
-  char *kwlist[] = {"shape",
-                    "Ax",
-                    "Ai",
-                    "Ap",
-                    "Px",
-                    "Pi",
-                    "Pp",
-                    "b",
-                    "c",
-                    "cone",
-                    "verbose",
-                    "normalize",
-                    "adaptive_scale",
-                    "max_iters",
-                    "scale",
-                    "eps_abs",
-                    "eps_rel",
-                    "eps_infeas",
-                    "alpha",
-                    "rho_x",
-                    "time_limit_secs",
-                    "acceleration_lookback",
-                    "acceleration_interval",
-                    "acceleration_type_1",
-                    "acceleration_regularization",
-                    "acceleration_relaxation",
-                    "write_data_filename",
-                    "log_csv_filename",
-                    NULL};
-
-/* parse the arguments and ensure they are the correct type */
-/* Use 'L' (long long) for DLONG so that scs_int fields are parsed correctly
-   on Windows where sizeof(long) < sizeof(long long) (LLP64 model). */
-#ifdef DLONG
-#ifdef SFLOAT
-  char *argparse_string = "(LL)O!O!O!OOOO!O!O!|O!O!O!LfffffffLLLffzz";
-#else
-  char *argparse_string = "(LL)O!O!O!OOOO!O!O!|O!O!O!LdddddddLLLddzz";
-#endif
-#else
-#ifdef SFLOAT
-  char *argparse_string = "(ii)O!O!O!OOOO!O!O!|O!O!O!ifffffffiiiffzz";
-#else
-  char *argparse_string = "(ii)O!O!O!OOOO!O!O!|O!O!O!idddddddiiiddzz";
-#endif
-#endif
-
-  /* Check that the workspace is not already initialized */
-  if (self->work) {
-    return finish_with_error("Workspace already setup!");
-  }
-
-  /* set defaults */
-  scs_set_default_settings(stgs);
-
-  /* clang-format off */
-  if (!PyArg_ParseTupleAndKeywords(
-          args, kwargs, argparse_string, kwlist, &(d->m), &(d->n),
-          &PyArray_Type, &Ax,
-          &PyArray_Type, &Ai,
-          &PyArray_Type, &Ap,
-          /* P can be None, so don't check is PyArray_Type */
-          /* TODO: Is there some other type that can handle None? */
-          &Px, &Pi, &Pp,
-          &PyArray_Type, &b,
-          &PyArray_Type, &c,
-          &PyDict_Type, &cone,
-          &PyBool_Type, &verbose,
-          &PyBool_Type, &normalize,
-          &PyBool_Type, &adaptive_scale,
-          &(stgs->max_iters),
-          &(stgs->scale),
-          &(stgs->eps_abs),
-          &(stgs->eps_rel),
-          &(stgs->eps_infeas),
-          &(stgs->alpha),
-          &(stgs->rho_x),
-          &(stgs->time_limit_secs),
-          &(stgs->acceleration_lookback),
-          &(stgs->acceleration_interval),
-          &(stgs->acceleration_type_1),
-          &(stgs->acceleration_regularization),
-          &(stgs->acceleration_relaxation),
-          &(stgs->write_data_filename),
-          &(stgs->log_csv_filename))) {
-    /* PyArg_ParseTupleAndKeywords already set an informative TypeError
-     * (e.g. "argument 14 must be int, not str"). Overwriting it with a
-     * generic ValueError would hide which input was rejected. */
-    free_py_scs_data(d, k, stgs, &ps);
+/* Replace *arr by a private copy of it. */
+static int own_copy(PyArrayObject **arr) {
+  PyArrayObject *copy = (PyArrayObject *)PyArray_NewCopy(*arr, NPY_CORDER);
+  if (!copy) {
     return -1;
   }
-  /* clang-format on */
+  Py_SETREF(*arr, copy);
+  return 0;
+}
 
-  if (d->m <= 0) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_error("m must be a positive integer");
-  }
+/* Replace *arr, which scs_get_contiguous made from the caller's `in`, by a
+ * private copy if it is `in` itself. */
+static int own_input(PyArrayObject **arr, PyArrayObject *in) {
+  return *arr == in ? own_copy(arr) : 0;
+}
 
-  if (d->n <= 0) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_error("n must be a positive integer");
-  }
+/* Drop the scratch b (or c, see the SCS struct) once the vector has been
+ * replaced whole, and return it (or NULL) for the caller to release once it
+ * holds the GIL. Needs the instance lock but not the GIL. */
+static PyArrayObject *drop_scratch_vector(PyArrayObject **scratch) {
+  PyArrayObject *old = *scratch;
+  *scratch = NULL;
+  return old;
+}
 
-  self->n = d->n;
-  self->m = d->m;
+/* Make OpenMP regions started by the calling thread use num_threads
+ * threads (0 keeps the current setting) and return the previous setting
+ * for restore_threads. The thread count is per calling thread, so this
+ * does not affect solves running on other threads. No-op without OpenMP.
+ * Needs no GIL. */
+static int use_threads(scs_int num_threads) {
+#ifdef _OPENMP
+  int prev = omp_get_max_threads();
+  if (num_threads > 0) {
+    omp_set_num_threads((int)num_threads);
+  }
+  return prev;
+#else
+  (void)num_threads;
+  return 0;
+#endif
+}
 
-  /* set A */
-  if (!PyArray_ISFLOAT(Ax) || PyArray_NDIM(Ax) != 1) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_type_error("Ax must be a 1-D numpy array of floats");
-  }
-  if (!PyArray_ISINTEGER(Ai) || PyArray_NDIM(Ai) != 1) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_type_error("Ai must be a 1-D numpy array of ints");
-  }
-  if (!PyArray_ISINTEGER(Ap) || PyArray_NDIM(Ap) != 1) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_type_error("Ap must be a 1-D numpy array of ints");
-  }
-  ps.Ax = scs_get_contiguous(Ax, scs_float_type);
-  ps.Ai = scs_get_contiguous(Ai, scs_int_type);
-  ps.Ap = scs_get_contiguous(Ap, scs_int_type);
-  if (!ps.Ax || !ps.Ai || !ps.Ap) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return -1;  /* numpy set the exception */
+static void restore_threads(scs_int num_threads, int prev) {
+#ifdef _OPENMP
+  if (num_threads > 0) {
+    omp_set_num_threads(prev);
   }
+#else
+  (void)num_threads;
+  (void)prev;
+#endif
+}
 
-  A = (ScsMatrix *)scs_malloc(sizeof(ScsMatrix));
-  if (!A) {
-    free_py_scs_data(d, k, stgs, &ps);
-    PyErr_NoMemory();
+/* Move the problem passed to scs_init into self (see SCS struct). On
+ * failure nothing has been moved and the caller still owns everything. */
+static int retain_problem(SCS *self, ScsData *d, ScsCone *k,
+                          ScsSettings *stgs, struct ScsPyData *ps) {
+  const char *write_data_filename = stgs->write_data_filename;
+  const char *log_csv_filename = stgs->log_csv_filename;
+  if (dup_settings_str(&write_data_filename) < 0) {
     return -1;
   }
-  A->n = d->n;
-  A->m = d->m;
-  A->x = (scs_float *)PyArray_DATA(ps.Ax);
-  A->i = (scs_int *)PyArray_DATA(ps.Ai);
-  A->p = (scs_int *)PyArray_DATA(ps.Ap);
-  d->A = A;
-
-  /* set P if passed in */
-  if (!Py_IsNone((PyObject *)Px) && !Py_IsNone((PyObject *)Pi) &&
-      !Py_IsNone((PyObject *)Pp)) {
-    /* Px/Pi/Pp are parsed with 'O' (to allow None), so we must guard
-     * PyArray_ISFLOAT/ISINTEGER with PyArray_Check — those macros read
-     * PyArrayObject-specific fields and are UB on non-array objects. */
-    if (!PyArray_Check((PyObject *)Px) || !PyArray_ISFLOAT(Px) ||
-        PyArray_NDIM(Px) != 1) {
-      free_py_scs_data(d, k, stgs, &ps);
-      return finish_with_type_error("Px must be a 1-D numpy array of floats");
-    }
-    if (!PyArray_Check((PyObject *)Pi) || !PyArray_ISINTEGER(Pi) ||
-        PyArray_NDIM(Pi) != 1) {
-      free_py_scs_data(d, k, stgs, &ps);
-      return finish_with_type_error("Pi must be a 1-D numpy array of ints");
-    }
-    if (!PyArray_Check((PyObject *)Pp) || !PyArray_ISINTEGER(Pp) ||
-        PyArray_NDIM(Pp) != 1) {
-      free_py_scs_data(d, k, stgs, &ps);
-      return finish_with_type_error("Pp must be a 1-D numpy array of ints");
-    }
-    ps.Px = scs_get_contiguous(Px, scs_float_type);
-    ps.Pi = scs_get_contiguous(Pi, scs_int_type);
-    ps.Pp = scs_get_contiguous(Pp, scs_int_type);
-    if (!ps.Px || !ps.Pi || !ps.Pp) {
-      free_py_scs_data(d, k, stgs, &ps);
-      return -1;  /* numpy set the exception */
-    }
+  if (dup_settings_str(&log_csv_filename) < 0) {
+    scs_free((char *)write_data_filename);
+    return -1;
+  }
+  d->b = d->c = NULL; /* the current ones are the workspace's */
+  stgs->write_data_filename = write_data_filename;
+  stgs->log_csv_filename = log_csv_filename;
+  self->d = d;
+  self->k = k;
+  self->stgs = stgs;
+  self->ps = *ps;
+  return 0;
+}
 
-    P = (ScsMatrix *)scs_malloc(sizeof(ScsMatrix));
-    if (!P) {
-      free_py_scs_data(d, k, stgs, &ps);
-      PyErr_NoMemory();
+/* The kept matrices are used after the call that passed them, so arrays
+ * borrowed from the caller by scs_get_contiguous are replaced by private
+ * copies: changing the caller's array in place (or the file under a memory
+ * map) must not change the kept problem, whose pattern update_matrices
+ * trusts without re-validating it. `in` holds the caller's Ax, Ai, Ap, Px,
+ * Pi and Pp, in the order of ScsPyData. */
+static int own_matrices(ScsData *d, struct ScsPyData *ps,
+                        PyArrayObject *const in[6]) {
+  PyArrayObject **kept[6] = {&ps->Ax, &ps->Ai, &ps->Ap,
+                             &ps->Px, &ps->Pi, &ps->Pp};
+  int i;
+  for (i = 0; i < 6; ++i) {
+    if (*kept[i] && own_input(kept[i], in[i]) < 0) {
       return -1;
     }
-    P->n = d->n;
-    P->m = d->n;
-    P->x = (scs_float *)PyArray_DATA(ps.Px);
-    P->i = (scs_int *)PyArray_DATA(ps.Pi);
-    P->p = (scs_int *)PyArray_DATA(ps.Pp);
-    d->P = P;
-  } else {
-    d->P = NULL;
-  }
-  /* set c */
-  if (!PyArray_ISFLOAT(c) || PyArray_NDIM(c) != 1) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_type_error(
-        "c must be a 1-D numpy array of floats");
-  }
-  if (PyArray_DIM(c, 0) != (npy_intp)d->n) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_error("c has incompatible dimension with A");
-  }
-  ps.c = scs_get_contiguous(c, scs_float_type);
-  if (!ps.c) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return -1;
   }
-  d->c = (scs_float *)PyArray_DATA(ps.c);
-  /* set b */
-  if (!PyArray_ISFLOAT(b) || PyArray_NDIM(b) != 1) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_type_error(
-        "b must be a 1-D numpy array of floats");
-  }
-  if (PyArray_DIM(b, 0) != (npy_intp)d->m) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_error("b has incompatible dimension with A");
+  d->A->x = (scs_float *)PyArray_DATA(ps->Ax);
+  d->A->i = (scs_int *)PyArray_DATA(ps->Ai);
+  d->A->p = (scs_int *)PyArray_DATA(ps->Ap);
+  if (ps->Px) {
+    d->P->x = (scs_float *)PyArray_DATA(ps->Px);
+    d->P->i = (scs_int *)PyArray_DATA(ps->Pi);
+    d->P->p = (scs_int *)PyArray_DATA(ps->Pp);
   }
-  ps.b = scs_get_contiguous(b, scs_float_type);
-  if (!ps.b) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return -1;
+  return 0;
+}
+
+static void free_retained_problem(SCS *self) {
+  if (self->stgs) {
+    scs_free((char *)self->stgs->write_data_filename);
+    scs_free((char *)self->stgs->log_csv_filename);
   }
-  d->b = (scs_float *)PyArray_DATA(ps.b);
+  free_py_scs_data(self->d, self->k, self->stgs, &self->ps);
+  self->d = NULL;
+  self->k = NULL;
+  self->stgs = NULL;
+  memset(&self->ps, 0, sizeof(self->ps));
+}
 
+/* Parse a cone dict into k, which the caller zeroed. Returns -1 with a
+ * Python exception set on failure; arrays parsed so far stay in k for
+ * the caller to free. */
+static int parse_cone(PyObject *cone, ScsCone *k) {
+  scs_int bsizeu, bsizel, f_tmp;
   if (get_pos_int_param("f", &(f_tmp), 0, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field f");
   }
   if (get_pos_int_param("z", &(k->z), 0, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field z");
   }
   if (f_tmp > 0) {
     /* PyErr_WarnEx returns -1 if the warning was promoted to an exception
      * (e.g. warnings.filterwarnings("error")); in that case the exception
-     * is already set, so we just need to clean up and return -1. */
+     * is already set and we just return -1. */
     if (PyErr_WarnEx(PyExc_DeprecationWarning,
                      "The 'f' cone field is deprecated; use 'z' (Zero cone) "
                      "instead. If both 'f' and 'z' are set they are summed.",
                      1) < 0) {
-      free_py_scs_data(d, k, stgs, &ps);
       return -1;
     }
     k->z += f_tmp;
   }
   if (get_pos_int_param("l", &(k->l), 0, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field l");
   }
   /* box cone */
   if (get_cone_float_arr("bu", &(k->bu), &bsizeu, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field bu");
   }
   if (get_cone_float_arr("bl", &(k->bl), &bsizel, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field bl");
   }
   if (bsizeu != bsizel) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("bu different dimension to bl");
   }
   if (bsizeu > 0) {
@@ -724,81 +659,69 @@ static int SCS_init(SCS *self, PyObject *args, PyObject *kwargs) {
   }
   /* end box cone */
   if (get_cone_arr_dim("q", &(k->q), &(k->qsize), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field q");
   }
   if (get_cone_arr_dim("s", &(k->s), &(k->ssize), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field s");
   }
   if (get_cone_arr_dim("cs", &(k->cs), &(k->cssize), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field cs");
   }
   if (get_cone_float_arr("p", &(k->p), &(k->psize), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("failed to parse cone field p");
   }
   if (get_pos_int_param("ep", &(k->ep), 0, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field ep");
   }
   if (get_pos_int_param("ed", &(k->ed), 0, cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field ed");
   }
 
 #ifdef USE_SPECTRAL_CONES
   /* logdet cone */
   if (get_cone_arr_dim("d", &(k->d), &(k->dsize), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field d");
   }
   /* nuclear norm cone */
   if (get_cone_arr_dim("nuc_m", &(k->nuc_m), &(k->nucsize), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field nuc_m");
   }
   {
     scs_int nuc_n_size = 0;
     if (get_cone_arr_dim("nuc_n", &(k->nuc_n), &nuc_n_size, cone) < 0) {
-      free_py_scs_data(d, k, stgs, &ps);
       return finish_with_error("Failed to parse cone field nuc_n");
     }
     if (nuc_n_size != k->nucsize) {
-      free_py_scs_data(d, k, stgs, &ps);
       return finish_with_error("nuc_m and nuc_n must have the same length");
     }
   }
   /* ell1 cone */
   if (get_cone_arr_dim("ell1", &(k->ell1), &(k->ell1_size), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field ell1");
   }
   /* sum of largest eigenvalues cone */
   if (get_cone_arr_dim("sl_n", &(k->sl_n), &(k->sl_size), cone) < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("Failed to parse cone field sl_n");
   }
   {
     scs_int sl_k_size = 0;
     if (get_cone_arr_dim("sl_k", &(k->sl_k), &sl_k_size, cone) < 0) {
-      free_py_scs_data(d, k, stgs, &ps);
       return finish_with_error("Failed to parse cone field sl_k");
     }
     if (sl_k_size != k->sl_size) {
-      free_py_scs_data(d, k, stgs, &ps);
       return finish_with_error("sl_n and sl_k must have the same length");
     }
   }
 #endif
+  return 0;
+}
 
-  stgs->verbose = verbose ? (scs_int)PyObject_IsTrue(verbose) : VERBOSE;
-  stgs->normalize = normalize ? (scs_int)PyObject_IsTrue(normalize) : NORMALIZE;
-  stgs->adaptive_scale = adaptive_scale
-                             ? (scs_int)PyObject_IsTrue(adaptive_scale)
-                             : ADAPTIVE_SCALE;
-
+/* Validate settings parsed from keywords (see SCS_init). Returns -1 with
+ * a ValueError naming the offending setting. */
+static int check_settings(const ScsSettings *stgs, scs_int num_threads) {
+  if (num_threads < 0) {
+    return finish_with_error("num_threads must be nonnegative");
+  }
   /* Ranges below match SCS's own validate() in scs_source/src/scs.c, plus
    * explicit isnan/isfinite guards that SCS's validate() lacks. Without
    * those, NaN values slip through every `x <= 0` / `x < 0` / `x >= 2`
@@ -808,419 +731,2052 @@ static int SCS_init(SCS *self, PyObject *args, PyObject *kwargs) {
    * allocation error!" or silently produces NaN. Better to raise a
    * Python exception naming the offending setting up front. */
   if (stgs->max_iters <= 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("max_iters must be positive");
   }
   /* acceleration_lookback: nonnegative memory size for AA. 0 disables
    * acceleration; the type (I or II) is selected by acceleration_type_1. */
   if (stgs->acceleration_lookback < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error(
         "acceleration_lookback must be nonnegative "
         "(use acceleration_type_1=0 for type-II AA)");
   }
   if (stgs->acceleration_interval <= 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("acceleration_interval must be positive");
   }
   if (!isfinite((double)stgs->acceleration_regularization) ||
       stgs->acceleration_regularization < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error(
         "acceleration_regularization must be a nonnegative finite number");
   }
   if (!isfinite((double)stgs->acceleration_relaxation) ||
       stgs->acceleration_relaxation < 0 ||
       stgs->acceleration_relaxation > 2) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("acceleration_relaxation must be in [0, 2]");
   }
   if (!isfinite((double)stgs->scale) || stgs->scale <= 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("scale must be a positive finite number");
   }
   /* time_limit_secs: 0 disables the limit, +inf is equivalent, both allowed. */
   if (isnan((double)stgs->time_limit_secs) || stgs->time_limit_secs < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("time_limit_secs must be nonnegative");
   }
   /* eps_*: +inf is allowed (effectively disables that stopping criterion);
    * NaN is not — it would make every tolerance comparison false. */
   if (isnan((double)stgs->eps_abs) || stgs->eps_abs < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("eps_abs must be nonnegative");
   }
   if (isnan((double)stgs->eps_rel) || stgs->eps_rel < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("eps_rel must be nonnegative");
   }
   if (isnan((double)stgs->eps_infeas) || stgs->eps_infeas < 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("eps_infeas must be nonnegative");
   }
   if (!isfinite((double)stgs->alpha) || stgs->alpha <= 0 || stgs->alpha >= 2) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("alpha must be in (0, 2)");
   }
   if (!isfinite((double)stgs->rho_x) || stgs->rho_x <= 0) {
-    free_py_scs_data(d, k, stgs, &ps);
     return finish_with_error("rho_x must be a positive finite number");
   }
-  stgs->warm_start = WARM_START; /* False by default */
-
-  /* Initialize solution struct. These allocations feed into the lifetime
-   * of self — SCS_finish unconditionally scs_free's them. Accept a
-   * zero-length calloc returning NULL only when the corresponding
-   * dimension is zero. */
-  self->sol = (ScsSolution *)scs_calloc(1, sizeof(ScsSolution));
-  if (!self->sol) {
-    free_py_scs_data(d, k, stgs, &ps);
-    PyErr_NoMemory();
-    return -1;
-  }
-  self->sol->x = (scs_float *)scs_calloc(self->n, sizeof(scs_float));
-  self->sol->y = (scs_float *)scs_calloc(self->m, sizeof(scs_float));
-  self->sol->s = (scs_float *)scs_calloc(self->m, sizeof(scs_float));
-  if ((self->n > 0 && !self->sol->x) ||
-      (self->m > 0 && (!self->sol->y || !self->sol->s))) {
-    free_py_scs_data(d, k, stgs, &ps);
-    /* SCS_finish (via tp_dealloc) will free whichever of x/y/s succeeded. */
-    PyErr_NoMemory();
-    return -1;
-  }
+  return 0;
+}
 
-  /* Allocate per-instance lock to protect work/sol from concurrent access.
-   * Needed because Py_BEGIN_ALLOW_THREADS releases the GIL during scs_solve,
-   * allowing concurrent calls on the same instance to race. */
-  self->lock = PyThread_allocate_lock();
-  if (!self->lock) {
-    free_py_scs_data(d, k, stgs, &ps);
-    return finish_with_error("Unable to allocate instance lock");
-  }
+/* The keyword settings shared by SCS_init and Settings_new, in kwlist
+ * order, with their PyArg format and argument pointers. Use 'L' (long
+ * long) for DLONG so that scs_int fields are parsed correctly on Windows
+ * where sizeof(long) < sizeof(long long) (LLP64 model). */
+#define SCS_SETTINGS_KWLIST                                                    \
+  "verbose", "normalize", "adaptive_scale", "max_iters", "scale", "eps_abs",   \
+      "eps_rel", "eps_infeas", "alpha", "rho_x", "time_limit_secs",            \
+      "acceleration_lookback", "acceleration_interval",                        \
+      "acceleration_type_1", "acceleration_regularization",                    \
+      "acceleration_relaxation", "write_data_filename", "log_csv_filename",    \
+      "num_threads", "keep_problem"
 
-  /* release the GIL */
-  Py_BEGIN_ALLOW_THREADS;
-  self->work = scs_init(d, k, stgs);
-  /* reacquire the GIL */
-  Py_END_ALLOW_THREADS;
+#ifdef DLONG
+#ifdef SFLOAT
+#define SCS_SETTINGS_FORMAT "O!O!O!LfffffffLLLffzzLO!"
+#else
+#define SCS_SETTINGS_FORMAT "O!O!O!LdddddddLLLddzzLO!"
+#endif
+#else
+#ifdef SFLOAT
+#define SCS_SETTINGS_FORMAT "O!O!O!ifffffffiiiffzziO!"
+#else
+#define SCS_SETTINGS_FORMAT "O!O!O!idddddddiiiddzziO!"
+#endif
+#endif
 
-  /* no longer need pointers to arrays that held primitives */
-  free_py_scs_data(d, k, stgs, &ps);
+/* clang-format off */
+#define SCS_SETTINGS_ARGS(stgs, verbose, normalize, adaptive_scale,           \
+                          num_threads, keep_problem)                           \
+  &PyBool_Type, &(verbose),                                                    \
+  &PyBool_Type, &(normalize),                                                  \
+  &PyBool_Type, &(adaptive_scale),                                             \
+  &((stgs)->max_iters),                                                        \
+  &((stgs)->scale),                                                            \
+  &((stgs)->eps_abs),                                                          \
+  &((stgs)->eps_rel),                                                          \
+  &((stgs)->eps_infeas),                                                       \
+  &((stgs)->alpha),                                                            \
+  &((stgs)->rho_x),                                                            \
+  &((stgs)->time_limit_secs),                                                  \
+  &((stgs)->acceleration_lookback),                                            \
+  &((stgs)->acceleration_interval),                                            \
+  &((stgs)->acceleration_type_1),                                              \
+  &((stgs)->acceleration_regularization),                                      \
+  &((stgs)->acceleration_relaxation),                                          \
+  &((stgs)->write_data_filename),                                              \
+  &((stgs)->log_csv_filename),                                                 \
+  &(num_threads),                                                              \
+  &PyBool_Type, &(keep_problem)
+/* clang-format on */
+
+static char *scs_settings_kwlist[] = {SCS_SETTINGS_KWLIST, NULL};
+
+/* Apply the bool settings, parsed as optional PyBool objects. */
+static void set_settings_flags(ScsSettings *stgs, PyObject *verbose,
+                               PyObject *normalize, PyObject *adaptive_scale) {
+  stgs->verbose = verbose ? (scs_int)PyObject_IsTrue(verbose) : VERBOSE;
+  stgs->normalize = normalize ? (scs_int)PyObject_IsTrue(normalize) : NORMALIZE;
+  stgs->adaptive_scale = adaptive_scale
+                             ? (scs_int)PyObject_IsTrue(adaptive_scale)
+                             : ADAPTIVE_SCALE;
+}
 
-  if (self->work) { /* Workspace allocation correct */
+/* Whether kwargs has any keyword setting (which settings=... replaces):
+ * 1 if so, 0 if not, -1 with a Python exception set if a lookup failed. */
+static int has_setting_kwargs(PyObject *kwargs) {
+  char **name;
+  if (!kwargs) {
     return 0;
   }
-  return finish_with_error("ScsWork allocation error!");
+  for (name = scs_settings_kwlist; *name; ++name) {
+    PyObject *obj = NULL;
+    int rc = PyDict_GetItemStringRef(kwargs, *name, &obj);
+    if (rc < 0) {
+      return -1;
+    }
+    if (obj) {
+      Py_DECREF(obj);
+      return 1;
+    }
+  }
+  return 0;
 }
 
-static PyObject *SCS_solve(SCS *self, PyObject *args) {
-  ScsInfo info = {0};
-  ScsSolution *sol = self->sol;
-  npy_intp veclen[1];
-  int scs_float_type = scs_get_float_type();
-
-  PyArrayObject *warm_x, *warm_y, *warm_s;
-  PyObject *warm_start;
+/* Settings parsed and validated once (scs.Settings). SCS_init copies them
+ * when given settings=..., skipping its own parsing and range checks. The
+ * filenames are private copies. Parsed in tp_new, with no tp_init, so a
+ * Settings cannot be changed (or its filenames freed) after creation. */
+typedef struct {
+  PyObject_HEAD
+  ScsSettings stgs;
+  scs_int num_threads;
+  int keep_problem;
+} ScsPySettings;
+
+static PyObject *Settings_new(PyTypeObject *type, PyObject *args,
+                              PyObject *kwargs) {
+  ScsPySettings *self;
+  ScsSettings stgs;
+  PyObject *verbose = NULL;
+  PyObject *normalize = NULL;
+  PyObject *adaptive_scale = NULL;
+  PyObject *keep_problem = NULL;
+  scs_int num_threads = 0;
 
-  /* clang-format off */
-  /* warm_* can be None, so don't check is PyArray_Type */
-  if (!PyArg_ParseTuple(args, "O!OOO",
-                        &PyBool_Type, &warm_start,
-                        &warm_x,
-                        &warm_y,
-                        &warm_s)) {
-    /* PyArg_ParseTuple already set an informative TypeError; propagate it. */
-    return (PyObject *)NULL;
+  scs_set_default_settings(&stgs);
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, "|$" SCS_SETTINGS_FORMAT, scs_settings_kwlist,
+          SCS_SETTINGS_ARGS(&stgs, verbose, normalize, adaptive_scale,
+                            num_threads, keep_problem))) {
+    return NULL;
   }
-  /* clang-format on */
+  set_settings_flags(&stgs, verbose, normalize, adaptive_scale);
+  if (check_settings(&stgs, num_threads) < 0) {
+    return NULL;
+  }
+  stgs.warm_start = WARM_START;
+  if (dup_settings_str(&stgs.write_data_filename) < 0) {
+    return NULL;
+  }
+  if (dup_settings_str(&stgs.log_csv_filename) < 0) {
+    scs_free((char *)stgs.write_data_filename);
+    return NULL;
+  }
+  self = (ScsPySettings *)type->tp_alloc(type, 0);
+  if (!self) {
+    scs_free((char *)stgs.write_data_filename);
+    scs_free((char *)stgs.log_csv_filename);
+    return NULL;
+  }
+  self->stgs = stgs;
+  self->num_threads = num_threads;
+  self->keep_problem = keep_problem && PyObject_IsTrue(keep_problem);
+  return (PyObject *)self;
+}
 
-  scs_int _warm_start = (scs_int)PyObject_IsTrue(warm_start);
+static void Settings_dealloc(ScsPySettings *self) {
+  scs_free((char *)self->stgs.write_data_filename);
+  scs_free((char *)self->stgs.log_csv_filename);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
 
-  /* Acquire per-instance lock. Release the GIL first to avoid deadlock:
-   * another thread may hold this lock inside scs_solve (with GIL released),
-   * so we must not hold the GIL while waiting for the lock. */
-  int lock_ok;
-  Py_BEGIN_ALLOW_THREADS;
-  lock_ok = (PyThread_acquire_lock(self->lock, WAIT_LOCK) == PY_LOCK_ACQUIRED);
-  Py_END_ALLOW_THREADS;
+static PyTypeObject ScsPySettings_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0) "scs.Settings", /* tp_name */
+    sizeof(ScsPySettings),                         /* tp_basicsize */
+    0,                                             /* tp_itemsize */
+    (destructor)Settings_dealloc,                  /* tp_dealloc */
+    0,                                             /* tp_print */
+    0,                                             /* tp_getattr */
+    0,                                             /* tp_setattr */
+    0,                                             /* tp_compare */
+    0,                                             /* tp_repr */
+    0,                                             /* tp_as_number */
+    0,                                             /* tp_as_sequence */
+    0,                                             /* tp_as_mapping */
+    0,                                             /* tp_hash */
+    0,                                             /* tp_call */
+    0,                                             /* tp_str */
+    0,                                             /* tp_getattro */
+    0,                                             /* tp_setattro */
+    0,                                             /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                            /* tp_flags */
+    "Validated SCS settings",                      /* tp_doc */
+    0,                                             /* tp_traverse */
+    0,                                             /* tp_clear */
+    0,                                             /* tp_richcompare */
+    0,                                             /* tp_weaklistoffset */
+    0,                                             /* tp_iter */
+    0,                                             /* tp_iternext */
+    0,                                             /* tp_methods */
+    0,                                             /* tp_members */
+    0,                                             /* tp_getset */
+    0,                                             /* tp_base */
+    0,                                             /* tp_dict */
+    0,                                             /* tp_descr_get */
+    0,                                             /* tp_descr_set */
+    0,                                             /* tp_dictoffset */
+    0,                                             /* tp_init */
+    0,                                             /* tp_alloc */
+    Settings_new,                                  /* tp_new */
+};
 
-  if (!lock_ok) {
-    return none_with_error("Failed to acquire instance lock");
+/* Set *dst to a new copy of the count elements of `size` bytes at src, or
+ * to NULL if there are none. */
+static int dup_cone_array(void **dst, const void *src, scs_int count,
+                          size_t size) {
+  *dst = NULL;
+  if (!src || count <= 0) {
+    return 0;
   }
-
-  /* Check workspace under lock to avoid TOCTOU race with SCS_finish */
-  if (!self->work) {
-    PyThread_release_lock(self->lock);
-    return none_with_error("Workspace not initialized!");
+  *dst = scs_malloc(count * size);
+  if (!*dst) {
+    PyErr_NoMemory();
+    return -1;
   }
+  memcpy(*dst, src, count * size);
+  return 0;
+}
 
-  if (_warm_start) {
-    /* If any of these of missing, we use the values in sol */
-    if (!Py_IsNone((PyObject *)warm_x)) {
-      if (get_warm_start(self->sol->x, self->n, warm_x) < 0) {
-        PyThread_release_lock(self->lock);
-        return none_with_error("Unable to parse x warm-start");
-      }
-    }
-    if (!Py_IsNone((PyObject *)warm_y)) {
-      if (get_warm_start(self->sol->y, self->m, warm_y) < 0) {
-        PyThread_release_lock(self->lock);
-        return none_with_error("Unable to parse y warm-start");
-      }
-    }
-    if (!Py_IsNone((PyObject *)warm_s)) {
-      if (get_warm_start(self->sol->s, self->m, warm_s) < 0) {
-        PyThread_release_lock(self->lock);
-        return none_with_error("Unable to parse s warm-start");
-      }
-    }
+/* Deep copy src into dst. On failure (MemoryError set) the arrays copied
+ * so far stay in dst for the caller to free, as with parse_cone. */
+static int copy_cone(ScsCone *dst, const ScsCone *src) {
+  scs_int bsize = src->bsize > 1 ? src->bsize - 1 : 0;
+  *dst = *src;
+  dst->bu = dst->bl = dst->p = NULL;
+  dst->q = dst->s = dst->cs = NULL;
+#ifdef USE_SPECTRAL_CONES
+  dst->d = dst->nuc_m = dst->nuc_n = dst->ell1 = dst->sl_n = dst->sl_k = NULL;
+#endif
+  /* clang-format off */
+  if (dup_cone_array((void **)&dst->bu, src->bu, bsize, sizeof(scs_float)) ||
+      dup_cone_array((void **)&dst->bl, src->bl, bsize, sizeof(scs_float)) ||
+      dup_cone_array((void **)&dst->q, src->q, src->qsize, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->s, src->s, src->ssize, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->cs, src->cs, src->cssize, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->p, src->p, src->psize, sizeof(scs_float))) {
+    return -1;
   }
-  /* else: SCS will overwite sol if _warm_start is false */
-  /* so we don't need to set to zeros here */
+#ifdef USE_SPECTRAL_CONES
+  if (dup_cone_array((void **)&dst->d, src->d, src->dsize, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->nuc_m, src->nuc_m, src->nucsize, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->nuc_n, src->nuc_n, src->nucsize, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->ell1, src->ell1, src->ell1_size, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->sl_n, src->sl_n, src->sl_size, sizeof(scs_int)) ||
+      dup_cone_array((void **)&dst->sl_k, src->sl_k, src->sl_size, sizeof(scs_int))) {
+    return -1;
+  }
+#endif
+  /* clang-format on */
+  return 0;
+}
 
-  PyObject *x, *y, *s, *return_dict, *info_dict, *aa_stats_dict;
-  scs_float *_x, *_y, *_s;
-  /* release the GIL */
-  Py_BEGIN_ALLOW_THREADS;
-  /* Solve! */
-  scs_solve(self->work, sol, &info, _warm_start);
-  Py_END_ALLOW_THREADS;
+/* A cone dict parsed once (scs.ConeSpec), which SCS_init copies instead of
+ * parsing when it is passed in place of the dict. Parsed in tp_new, with no
+ * tp_init, so the arrays cannot be replaced after creation. */
+typedef struct {
+  PyObject_HEAD
+  ScsCone k;
+} ScsPyConeSpec;
 
-  /* Copy results out of sol while still holding the lock, because another
-   * thread's solve could overwrite sol as soon as we release.
-   * Note: unlike SCS_update, we release the lock after Py_END_ALLOW_THREADS
-   * because we need to read from sol (shared state) under lock protection. */
-  _x = scs_malloc(self->n * sizeof(scs_float));
-  _y = scs_malloc(self->m * sizeof(scs_float));
-  _s = scs_malloc(self->m * sizeof(scs_float));
-  if ((self->n > 0 && !_x) || (self->m > 0 && (!_y || !_s))) {
-    scs_free(_x);
-    scs_free(_y);
-    scs_free(_s);
-    PyThread_release_lock(self->lock);
-    PyErr_NoMemory();
+static PyObject *ConeSpec_new(PyTypeObject *type, PyObject *args,
+                              PyObject *kwargs) {
+  static char *kwlist[] = {"cone", NULL};
+  ScsPyConeSpec *self;
+  PyObject *cone;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!", kwlist, &PyDict_Type,
+                                   &cone)) {
     return NULL;
   }
-  memcpy(_x, sol->x, self->n * sizeof(scs_float));
-  memcpy(_y, sol->y, self->m * sizeof(scs_float));
-  memcpy(_s, sol->s, self->m * sizeof(scs_float));
-
-  PyThread_release_lock(self->lock);
-
-  /* Build numpy arrays from the copied data (no longer under lock since
-   * these are thread-local copies). If PyArray_SimpleNewFromData fails
-   * (OOM), it sets a Python exception but does NOT take ownership of the
-   * buffer — so we must free the raw buffer ourselves and Py_DECREF any
-   * arrays already built (which own their buffers via NPY_ARRAY_OWNDATA). */
-  veclen[0] = self->n;
-  x = PyArray_SimpleNewFromData(1, veclen, scs_float_type, _x);
-  if (!x) {
-    scs_free(_x);
-    scs_free(_y);
-    scs_free(_s);
+  /* tp_alloc zeroes k; on failure dealloc frees what was parsed. */
+  self = (ScsPyConeSpec *)type->tp_alloc(type, 0);
+  if (!self) {
     return NULL;
   }
-  PyArray_ENABLEFLAGS((PyArrayObject *)x, NPY_ARRAY_OWNDATA);
-
-  veclen[0] = self->m;
-  y = PyArray_SimpleNewFromData(1, veclen, scs_float_type, _y);
-  if (!y) {
-    scs_free(_y);
-    scs_free(_s);
-    Py_DECREF(x);
+  if (parse_cone(cone, &self->k) < 0) {
+    Py_DECREF(self);
     return NULL;
   }
-  PyArray_ENABLEFLAGS((PyArrayObject *)y, NPY_ARRAY_OWNDATA);
+  return (PyObject *)self;
+}
 
-  veclen[0] = self->m;
-  s = PyArray_SimpleNewFromData(1, veclen, scs_float_type, _s);
-  if (!s) {
-    scs_free(_s);
-    Py_DECREF(x);
-    Py_DECREF(y);
-    return NULL;
+static void ConeSpec_dealloc(ScsPyConeSpec *self) {
+  free_cone_arrays(&self->k);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyTypeObject ScsPyConeSpec_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0) "scs.ConeSpec", /* tp_name */
+    sizeof(ScsPyConeSpec),                         /* tp_basicsize */
+    0,                                             /* tp_itemsize */
+    (destructor)ConeSpec_dealloc,                  /* tp_dealloc */
+    0,                                             /* tp_print */
+    0,                                             /* tp_getattr */
+    0,                                             /* tp_setattr */
+    0,                                             /* tp_compare */
+    0,                                             /* tp_repr */
+    0,                                             /* tp_as_number */
+    0,                                             /* tp_as_sequence */
+    0,                                             /* tp_as_mapping */
+    0,                                             /* tp_hash */
+    0,                                             /* tp_call */
+    0,                                             /* tp_str */
+    0,                                             /* tp_getattro */
+    0,                                             /* tp_setattro */
+    0,                                             /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                            /* tp_flags */
+    "Parsed SCS cone",                             /* tp_doc */
+    0,                                             /* tp_traverse */
+    0,                                             /* tp_clear */
+    0,                                             /* tp_richcompare */
+    0,                                             /* tp_weaklistoffset */
+    0,                                             /* tp_iter */
+    0,                                             /* tp_iternext */
+    0,                                             /* tp_methods */
+    0,                                             /* tp_members */
+    0,                                             /* tp_getset */
+    0,                                             /* tp_base */
+    0,                                             /* tp_dict */
+    0,                                             /* tp_descr_get */
+    0,                                             /* tp_descr_set */
+    0,                                             /* tp_dictoffset */
+    0,                                             /* tp_init */
+    0,                                             /* tp_alloc */
+    ConeSpec_new,                                  /* tp_new */
+};
+
+static int SCS_init(SCS *self, PyObject *args, PyObject *kwargs) {
+  /* data structures for arguments */
+  PyArrayObject *Ax, *Ai, *Ap, *Px, *Pi, *Pp, *c, *b;
+  PyObject *cone;
+  PyObject *verbose = NULL;
+  PyObject *normalize = NULL;
+  PyObject *adaptive_scale = NULL;
+  PyObject *settings = NULL;
+  PyObject *keep_problem_obj = NULL;
+  int keep_problem;
+  /* get the typenum for the primitive scs_int and scs_float types */
+  int scs_int_type = scs_get_int_type();
+  int scs_float_type = scs_get_float_type();
+  scs_int num_threads = 0;
+  int prev_threads;
+  struct ScsPyData ps = {0};
+  /* scs data structures */
+  ScsData *d = (ScsData *)scs_calloc(1, sizeof(ScsData));
+  ScsCone *k = (ScsCone *)scs_calloc(1, sizeof(ScsCone));
+  ScsSettings *stgs = (ScsSettings *)scs_calloc(1, sizeof(ScsSettings));
+  if (!d || !k || !stgs) {
+    scs_free(d);
+    scs_free(k);
+    scs_free(stgs);
+    PyErr_NoMemory();
+    return -1;
   }
-  PyArray_ENABLEFLAGS((PyArrayObject *)s, NPY_ARRAY_OWNDATA);
 
-/* output arguments */
-/* Use 'L' (long long) for scs_int under DLONG to match scs_int's typedef
- * (long long); 'l' (long) would truncate to 32 bits on LLP64 Windows.
- * Mirrors the argparse_string choice in SCS_init. */
+  ScsMatrix *A, *P;
+  char *kwlist[] = {"shape", "Ax", "Ai", "Ap", "Px", "Pi", "Pp", "b", "c",
+                    "cone", SCS_SETTINGS_KWLIST, "settings", NULL};
+
+/* parse the arguments and ensure they are the correct type */
 #ifdef DLONG
-#ifdef SFLOAT
-  char *outarg_string = "{s:L,s:L,s:L,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,"
-                        "s:f,s:f,s:f,s:f,s:f,s:L,s:L,s:s}";
-  char *aa_stats_string = "{s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:f,s:f}";
+  char *argparse_string = "(LL)O!O!O!OOOO!O!O|" SCS_SETTINGS_FORMAT "O!";
 #else
-  char *outarg_string = "{s:L,s:L,s:L,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,"
-                        "s:d,s:d,s:d,s:d,s:d,s:L,s:L,s:s}";
-  char *aa_stats_string = "{s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:d,s:d}";
+  char *argparse_string = "(ii)O!O!O!OOOO!O!O|" SCS_SETTINGS_FORMAT "O!";
 #endif
-#else
-#ifdef SFLOAT
-  char *outarg_string = "{s:i,s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,"
-                        "s:f,s:f,s:f,s:f,s:f,s:i,s:i,s:s}";
+
+  /* Check that the workspace is not already initialized */
+  if (self->work) {
+    return finish_with_error("Workspace already setup!");
+  }
+
+  /* set defaults */
+  scs_set_default_settings(stgs);
+
+  /* Released in SCS_finish, so error paths below need not clean it up. */
+  Py_CLEAR(self->converted_inputs);
+  self->converted_inputs = PyList_New(0);
+  if (!self->converted_inputs) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+
+  /* clang-format off */
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, argparse_string, kwlist, &(d->m), &(d->n),
+          &PyArray_Type, &Ax,
+          &PyArray_Type, &Ai,
+          &PyArray_Type, &Ap,
+          /* P can be None, so don't check is PyArray_Type */
+          /* TODO: Is there some other type that can handle None? */
+          &Px, &Pi, &Pp,
+          &PyArray_Type, &b,
+          &PyArray_Type, &c,
+          /* a dict or a ConeSpec, checked below */
+          &cone,
+          SCS_SETTINGS_ARGS(stgs, verbose, normalize, adaptive_scale,
+                            num_threads, keep_problem_obj),
+          &ScsPySettings_Type, &settings)) {
+    /* PyArg_ParseTupleAndKeywords already set an informative TypeError
+     * (e.g. "argument 14 must be int, not str"). Overwriting it with a
+     * generic ValueError would hide which input was rejected. */
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+  /* clang-format on */
+
+  if (!PyDict_Check(cone) && !PyObject_TypeCheck(cone, &ScsPyConeSpec_Type)) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_type_error("cone must be a dict or a ConeSpec");
+  }
+  if (settings) {
+    int rc = has_setting_kwargs(kwargs);
+    if (rc != 0) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return rc < 0 ? -1
+                    : finish_with_type_error(
+                          "settings cannot be combined with keyword settings");
+    }
+  }
+
+  if (d->m <= 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_error("m must be a positive integer");
+  }
+
+  if (d->n <= 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_error("n must be a positive integer");
+  }
+
+  self->n = d->n;
+  self->m = d->m;
+
+  /* set A */
+  if (!PyArray_ISFLOAT(Ax) || PyArray_NDIM(Ax) != 1) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_type_error("Ax must be a 1-D numpy array of floats");
+  }
+  if (!PyArray_ISINTEGER(Ai) || PyArray_NDIM(Ai) != 1) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_type_error("Ai must be a 1-D numpy array of ints");
+  }
+  if (!PyArray_ISINTEGER(Ap) || PyArray_NDIM(Ap) != 1) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_type_error("Ap must be a 1-D numpy array of ints");
+  }
+  ps.Ax = scs_get_contiguous(Ax, scs_float_type);
+  ps.Ai = scs_get_contiguous(Ai, scs_int_type);
+  ps.Ap = scs_get_contiguous(Ap, scs_int_type);
+  if (!ps.Ax || !ps.Ai || !ps.Ap) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;  /* numpy set the exception */
+  }
+  if (record_conversion(self->converted_inputs, Ax, ps.Ax, "Ax") < 0 ||
+      record_conversion(self->converted_inputs, Ai, ps.Ai, "Ai") < 0 ||
+      record_conversion(self->converted_inputs, Ap, ps.Ap, "Ap") < 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+
+  A = (ScsMatrix *)scs_malloc(sizeof(ScsMatrix));
+  if (!A) {
+    free_py_scs_data(d, k, stgs, &ps);
+    PyErr_NoMemory();
+    return -1;
+  }
+  A->n = d->n;
+  A->m = d->m;
+  A->x = (scs_float *)PyArray_DATA(ps.Ax);
+  A->i = (scs_int *)PyArray_DATA(ps.Ai);
+  A->p = (scs_int *)PyArray_DATA(ps.Ap);
+  d->A = A;
+
+  /* set P if passed in */
+  if (!Py_IsNone((PyObject *)Px) && !Py_IsNone((PyObject *)Pi) &&
+      !Py_IsNone((PyObject *)Pp)) {
+    /* Px/Pi/Pp are parsed with 'O' (to allow None), so we must guard
+     * PyArray_ISFLOAT/ISINTEGER with PyArray_Check — those macros read
+     * PyArrayObject-specific fields and are UB on non-array objects. */
+    if (!PyArray_Check((PyObject *)Px) || !PyArray_ISFLOAT(Px) ||
+        PyArray_NDIM(Px) != 1) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return finish_with_type_error("Px must be a 1-D numpy array of floats");
+    }
+    if (!PyArray_Check((PyObject *)Pi) || !PyArray_ISINTEGER(Pi) ||
+        PyArray_NDIM(Pi) != 1) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return finish_with_type_error("Pi must be a 1-D numpy array of ints");
+    }
+    if (!PyArray_Check((PyObject *)Pp) || !PyArray_ISINTEGER(Pp) ||
+        PyArray_NDIM(Pp) != 1) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return finish_with_type_error("Pp must be a 1-D numpy array of ints");
+    }
+    ps.Px = scs_get_contiguous(Px, scs_float_type);
+    ps.Pi = scs_get_contiguous(Pi, scs_int_type);
+    ps.Pp = scs_get_contiguous(Pp, scs_int_type);
+    if (!ps.Px || !ps.Pi || !ps.Pp) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return -1;  /* numpy set the exception */
+    }
+    if (record_conversion(self->converted_inputs, Px, ps.Px, "Px") < 0 ||
+        record_conversion(self->converted_inputs, Pi, ps.Pi, "Pi") < 0 ||
+        record_conversion(self->converted_inputs, Pp, ps.Pp, "Pp") < 0) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return -1;
+    }
+
+    P = (ScsMatrix *)scs_malloc(sizeof(ScsMatrix));
+    if (!P) {
+      free_py_scs_data(d, k, stgs, &ps);
+      PyErr_NoMemory();
+      return -1;
+    }
+    P->n = d->n;
+    P->m = d->n;
+    P->x = (scs_float *)PyArray_DATA(ps.Px);
+    P->i = (scs_int *)PyArray_DATA(ps.Pi);
+    P->p = (scs_int *)PyArray_DATA(ps.Pp);
+    d->P = P;
+  } else {
+    d->P = NULL;
+  }
+  /* set c */
+  if (!PyArray_ISFLOAT(c) || PyArray_NDIM(c) != 1) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_type_error(
+        "c must be a 1-D numpy array of floats");
+  }
+  if (PyArray_DIM(c, 0) != (npy_intp)d->n) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_error("c has incompatible dimension with A");
+  }
+  ps.c = scs_get_contiguous(c, scs_float_type);
+  if (!ps.c || record_conversion(self->converted_inputs, c, ps.c, "c") < 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+  d->c = (scs_float *)PyArray_DATA(ps.c);
+  /* set b */
+  if (!PyArray_ISFLOAT(b) || PyArray_NDIM(b) != 1) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_type_error(
+        "b must be a 1-D numpy array of floats");
+  }
+  if (PyArray_DIM(b, 0) != (npy_intp)d->m) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_error("b has incompatible dimension with A");
+  }
+  ps.b = scs_get_contiguous(b, scs_float_type);
+  if (!ps.b || record_conversion(self->converted_inputs, b, ps.b, "b") < 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+  d->b = (scs_float *)PyArray_DATA(ps.b);
+
+  if ((PyDict_Check(cone) ? parse_cone(cone, k)
+                          : copy_cone(k, &((ScsPyConeSpec *)cone)->k)) < 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+
+  if (settings) {
+    /* Already validated. The filenames are borrowed from settings, which
+     * the call keeps alive, until retain_problem copies them. */
+    *stgs = ((ScsPySettings *)settings)->stgs;
+    num_threads = ((ScsPySettings *)settings)->num_threads;
+    keep_problem = ((ScsPySettings *)settings)->keep_problem;
+  } else {
+    keep_problem = keep_problem_obj && PyObject_IsTrue(keep_problem_obj);
+    set_settings_flags(stgs, verbose, normalize, adaptive_scale);
+    if (check_settings(stgs, num_threads) < 0) {
+      free_py_scs_data(d, k, stgs, &ps);
+      return -1;
+    }
+  }
+  self->num_threads = num_threads;
+  stgs->warm_start = WARM_START; /* False by default */
+
+  /* Initialize solution struct. These allocations feed into the lifetime
+   * of self — SCS_finish unconditionally scs_free's them. Accept a
+   * zero-length calloc returning NULL only when the corresponding
+   * dimension is zero. */
+  self->sol = (ScsSolution *)scs_calloc(1, sizeof(ScsSolution));
+  if (!self->sol) {
+    free_py_scs_data(d, k, stgs, &ps);
+    PyErr_NoMemory();
+    return -1;
+  }
+  self->sol->x = (scs_float *)scs_calloc(self->n, sizeof(scs_float));
+  self->sol->y = (scs_float *)scs_calloc(self->m, sizeof(scs_float));
+  self->sol->s = (scs_float *)scs_calloc(self->m, sizeof(scs_float));
+  if ((self->n > 0 && !self->sol->x) ||
+      (self->m > 0 && (!self->sol->y || !self->sol->s))) {
+    free_py_scs_data(d, k, stgs, &ps);
+    /* SCS_finish (via tp_dealloc) will free whichever of x/y/s succeeded. */
+    PyErr_NoMemory();
+    return -1;
+  }
+
+  /* Allocate per-instance lock to protect work/sol from concurrent access.
+   * Needed because Py_BEGIN_ALLOW_THREADS releases the GIL during scs_solve,
+   * allowing concurrent calls on the same instance to race. */
+  self->lock = PyThread_allocate_lock();
+  if (!self->lock) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_error("Unable to allocate instance lock");
+  }
+
+  /* release the GIL */
+  Py_BEGIN_ALLOW_THREADS;
+  prev_threads = use_threads(self->num_threads);
+  self->work = scs_init(d, k, stgs);
+  restore_threads(self->num_threads, prev_threads);
+  /* reacquire the GIL */
+  Py_END_ALLOW_THREADS;
+
+  if (!self->work) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return finish_with_error("ScsWork allocation error!");
+  }
+
+  /* scs_init copied A, P, b and c into the workspace, so inputs borrowed
+   * from the caller by scs_get_contiguous only had to outlive that call.
+   * b and c are dropped: the workspace holds the current ones, and partial
+   * updates copy them from there (see the SCS struct). With keep_problem
+   * the rest is kept, for update_matrices and save_problem: the matrices as
+   * our own arrays (the values are replaced when they are updated), and the
+   * filenames in stgs duplicated because they point into the kwargs.
+   * Otherwise it is freed now, including any converted copies. */
+  PyArrayObject *const inputs[6] = {Ax, Ai, Ap, Px, Pi, Pp};
+  Py_CLEAR(ps.b);
+  Py_CLEAR(ps.c);
+  if (!keep_problem) {
+    free_py_scs_data(d, k, stgs, &ps);
+  } else if (own_matrices(d, &ps, inputs) < 0 ||
+             retain_problem(self, d, k, stgs, &ps) < 0) {
+    free_py_scs_data(d, k, stgs, &ps);
+    return -1;
+  }
+  return 0;
+}
+
+/* Validate a caller-provided output array for solve(out_x=...). The array
+ * is written in place, so unlike inputs it cannot be cast or made
+ * contiguous on the fly: it must already be a writeable, aligned,
+ * C-contiguous 1-D array of native-byte-order scs_float of length l. Sets
+ * a Python exception and returns -1 on failure. */
+static int check_out_buffer(PyObject *out, scs_int l, const char *name) {
+  if (!PyArray_Check(out) ||
+      !PyArray_EquivTypenums(PyArray_TYPE((PyArrayObject *)out),
+                             scs_get_float_type()) ||
+      !PyArray_ISNOTSWAPPED((PyArrayObject *)out) ||
+      PyArray_NDIM((PyArrayObject *)out) != 1) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s must be a 1-D numpy array of native-order dtype float%d",
+                 name, (int)(8 * sizeof(scs_float)));
+    return -1;
+  }
+  if (PyArray_DIM((PyArrayObject *)out, 0) != (npy_intp)l) {
+    PyErr_Format(PyExc_ValueError, "%s must have length %ld", name, (long)l);
+    return -1;
+  }
+  if (!PyArray_IS_C_CONTIGUOUS((PyArrayObject *)out) ||
+      !PyArray_ISALIGNED((PyArrayObject *)out) ||
+      !PyArray_ISWRITEABLE((PyArrayObject *)out)) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s must be writeable, aligned and C-contiguous", name);
+    return -1;
+  }
+  return 0;
+}
+
+/* Check that two caller-provided output arrays (None for absent), already
+ * validated by check_out_buffer and so contiguous, share no memory: one
+ * would silently overwrite the other. */
+static int check_out_disjoint(PyObject *a, const char *a_name, PyObject *b,
+                              const char *b_name) {
+  const char *a_lo, *b_lo;
+  if (Py_IsNone(a) || Py_IsNone(b)) {
+    return 0;
+  }
+  a_lo = (const char *)PyArray_DATA((PyArrayObject *)a);
+  b_lo = (const char *)PyArray_DATA((PyArrayObject *)b);
+  if (a_lo < b_lo + PyArray_NBYTES((PyArrayObject *)b) &&
+      b_lo < a_lo + PyArray_NBYTES((PyArrayObject *)a)) {
+    PyErr_Format(PyExc_ValueError, "%s and %s must not share memory",
+                 a_name, b_name);
+    return -1;
+  }
+  return 0;
+}
+
+/* Copy l entries of src into the caller's output array if one was given,
+ * otherwise into a fresh scs_malloc'd buffer returned through *fresh. The
+ * fresh buffer is handed to numpy once the instance lock is released.
+ * Returns -1 (without a Python exception: the GIL is not held) on OOM. */
+static int copy_solution_vec(scs_float **fresh, PyObject *out,
+                             const scs_float *src, scs_int l) {
+  if (!Py_IsNone(out)) {
+    memcpy(PyArray_DATA((PyArrayObject *)out), src, l * sizeof(scs_float));
+    return 0;
+  }
+  *fresh = (scs_float *)scs_malloc(l * sizeof(scs_float));
+  if (l > 0 && !*fresh) {
+    return -1;
+  }
+  memcpy(*fresh, src, l * sizeof(scs_float));
+  return 0;
+}
+
+/* Return the caller's output array (new reference) if one was given,
+ * otherwise wrap buf in a numpy array that takes ownership of it. If
+ * PyArray_SimpleNewFromData fails (OOM), it sets a Python exception but
+ * does NOT take ownership of the buffer — so we free it here. */
+static PyObject *solution_vec_array(scs_float *buf, PyObject *out,
+                                    scs_int l) {
+  npy_intp veclen[1];
+  PyObject *arr;
+  if (!Py_IsNone(out)) {
+    Py_INCREF(out);
+    return out;
+  }
+  veclen[0] = l;
+  arr = PyArray_SimpleNewFromData(1, veclen, scs_get_float_type(), buf);
+  if (!arr) {
+    scs_free(buf);
+    return NULL;
+  }
+  PyArray_ENABLEFLAGS((PyArrayObject *)arr, NPY_ARRAY_OWNDATA);
+  return arr;
+}
+
+/* A field of a C struct exposed to numpy as a structured dtype. */
+typedef struct {
+  const char *name;
+  size_t offset;
+  int is_int; /* scs_int if set, else scs_float */
+} ScsPyField;
+
+#define SCS_TRACE_INT_FIELD(name)                                              \
+  { #name, offsetof(ScsPyTraceRow, name), 1 }
+#define SCS_TRACE_FLOAT_FIELD(name)                                            \
+  { #name, offsetof(ScsPyTraceRow, name), 0 }
+
+static const ScsPyField scs_trace_fields[] = {
+    SCS_TRACE_INT_FIELD(iter),       SCS_TRACE_FLOAT_FIELD(res_pri),
+    SCS_TRACE_FLOAT_FIELD(res_dual), SCS_TRACE_FLOAT_FIELD(gap),
+    SCS_TRACE_FLOAT_FIELD(pobj),     SCS_TRACE_FLOAT_FIELD(dobj),
+    SCS_TRACE_FLOAT_FIELD(scale),
+};
+
+#undef SCS_TRACE_INT_FIELD
+#undef SCS_TRACE_FLOAT_FIELD
+
+#define SCS_NUM_FIELDS(fields) ((Py_ssize_t)(sizeof(fields) / sizeof(fields[0])))
+
+/* Returns a new reference to the structured dtype describing a struct of
+ * `itemsize` bytes with the given fields, or NULL with a Python exception
+ * set. */
+static PyArray_Descr *scs_struct_descr(const ScsPyField *fields,
+                                       Py_ssize_t nfields, size_t itemsize) {
+  Py_ssize_t i;
+  PyArray_Descr *descr = NULL;
+  PyObject *names = PyList_New(nfields);
+  PyObject *formats = PyList_New(nfields);
+  PyObject *offsets = PyList_New(nfields);
+  PyObject *spec = NULL;
+  if (!names || !formats || !offsets) {
+    goto done;
+  }
+  for (i = 0; i < nfields; ++i) {
+    int typenum =
+        fields[i].is_int ? scs_get_int_type() : scs_get_float_type();
+    PyObject *name = PyUnicode_FromString(fields[i].name);
+    PyObject *fmt = (PyObject *)PyArray_DescrFromType(typenum);
+    PyObject *off = PyLong_FromSize_t(fields[i].offset);
+    if (!name || !fmt || !off) {
+      Py_XDECREF(name);
+      Py_XDECREF(fmt);
+      Py_XDECREF(off);
+      goto done;
+    }
+    /* PyList_SET_ITEM steals the references */
+    PyList_SET_ITEM(names, i, name);
+    PyList_SET_ITEM(formats, i, fmt);
+    PyList_SET_ITEM(offsets, i, off);
+  }
+  spec = Py_BuildValue("{s:O,s:O,s:O,s:n}", "names", names, "formats",
+                       formats, "offsets", offsets, "itemsize",
+                       (Py_ssize_t)itemsize);
+  if (spec && !PyArray_DescrConverter(spec, &descr)) {
+    descr = NULL;
+  }
+done:
+  Py_XDECREF(names);
+  Py_XDECREF(formats);
+  Py_XDECREF(offsets);
+  Py_XDECREF(spec);
+  return descr;
+}
+
+/* Take self's instance lock, releasing the GIL while waiting for it.
+ * Returns 1 once held, 0 if it could not be taken. A progress callback
+ * runs while its solve holds the lock, so when the calling thread is
+ * inside a solve on self (i.e. in its callback) this fails at once with a
+ * RuntimeError instead of waiting forever. */
+static int lock_instance(SCS *self) {
+  int ok;
+  if (scs_py_progress_running(self)) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "a progress callback cannot use the instance it was "
+                    "called from");
+    return 0;
+  }
+  Py_BEGIN_ALLOW_THREADS;
+  ok = (PyThread_acquire_lock(self->lock, WAIT_LOCK) == PY_LOCK_ACQUIRED);
+  Py_END_ALLOW_THREADS;
+  return ok;
+}
+
+/* Register self's progress callback (if any) for the solves this thread
+ * is about to run on self->work, with a trace ring if `trace` is set and
+ * tracing is enabled. Call with the GIL and instance lock held; unless it
+ * fails (returning -1 with an exception set) every call must be paired
+ * with end_progress. */
+static int begin_progress(SCS *self, ScsPyProgress *p, int trace) {
+  memset(p, 0, sizeof(*p));
+  if (trace && self->trace_stride > 0) {
+    p->trace = (ScsPyTraceRow *)scs_malloc(self->trace_cap *
+                                           sizeof(ScsPyTraceRow));
+    if (!p->trace) {
+      PyErr_NoMemory();
+      return -1;
+    }
+    p->trace_cap = self->trace_cap;
+    p->trace_stride = self->trace_stride;
+  }
+  p->callback = Py_XNewRef(self->callback);
+  p->interval = self->callback_interval;
+  p->work = self->work;
+  p->owner = self;
+  p->prev = scs_py_progress_set(p);
+  return 0;
+}
+
+/* The samples in p's trace ring, oldest first, as a structured array (see
+ * scs_trace_fields). Call with the GIL held, before end_progress. */
+static PyObject *progress_trace_array(const ScsPyProgress *p) {
+  npy_intp dims[1];
+  PyArray_Descr *descr;
+  PyObject *arr;
+  scs_int len = p->trace_count < p->trace_cap ? p->trace_count : p->trace_cap;
+  scs_int start = p->trace_count - len; /* oldest kept sample */
+  scs_int head = start % (p->trace_cap ? p->trace_cap : 1);
+  ScsPyTraceRow *out;
+
+  descr = scs_struct_descr(scs_trace_fields, SCS_NUM_FIELDS(scs_trace_fields),
+                           sizeof(ScsPyTraceRow));
+  if (!descr) {
+    return NULL;
+  }
+  dims[0] = len;
+  /* PyArray_NewFromDescr steals the reference to descr */
+  arr = PyArray_NewFromDescr(&PyArray_Type, descr, 1, dims, NULL, NULL, 0,
+                             NULL);
+  if (!arr || len == 0) {
+    return arr;
+  }
+  /* Unroll the ring: [head, cap) then [0, head). */
+  out = (ScsPyTraceRow *)PyArray_DATA((PyArrayObject *)arr);
+  memcpy(out, p->trace + head, (len - head) * sizeof(ScsPyTraceRow));
+  memcpy(out + (len - head), p->trace, head * sizeof(ScsPyTraceRow));
+  return arr;
+}
+
+#ifdef SCS_PY_CG_STATS
+/* The CG iteration counts of p's solve as the info["lin_sys_iters"] dict:
+ * the total, the max and mean per ADMM iteration, and 'hist', the
+ * histogram of per-iteration counts over power-of-two bins (see
+ * SCS_PY_CG_HIST_BINS) up to the last nonempty one. Call with the GIL
+ * held. */
+static PyObject *progress_cg_dict(const ScsPyProgress *p) {
+  npy_intp dims[1] = {1};
+  PyObject *hist, *ret;
+  scs_int i;
+  for (i = 0; i < SCS_PY_CG_HIST_BINS; ++i) {
+    if (p->cg_hist[i]) {
+      dims[0] = i + 1;
+    }
+  }
+  hist = PyArray_SimpleNew(1, dims, scs_get_int_type());
+  if (!hist) {
+    return NULL;
+  }
+  memcpy(PyArray_DATA((PyArrayObject *)hist), p->cg_hist,
+         dims[0] * sizeof(scs_int));
+  ret = Py_BuildValue(
+      "{s:L,s:L,s:d,s:O}", "total", (long long)p->cg_its, "max",
+      (long long)p->cg_max, "mean",
+      p->polls ? (double)p->cg_its / p->polls : 0., "hist", hist);
+  Py_DECREF(hist);
+  return ret;
+}
+#endif
+
+/* Call after scs_py_progress_finish: a solve that p stopped (callback or
+ * stop byte) ran its iteration loop to an early, normal end, so info holds
+ * the last iterate's finite residuals; report it as interrupted unless it
+ * converged in that last iteration anyway. Does not need the GIL. */
+static void progress_mark_stopped(const ScsPyProgress *p, ScsInfo *info) {
+  if (p->stopped && info->status_val != SCS_SOLVED &&
+      info->status_val != SCS_INFEASIBLE &&
+      info->status_val != SCS_UNBOUNDED) {
+    info->status_val = SCS_SIGINT;
+    strcpy(info->status, "interrupted");
+  }
+}
+
+/* Undo begin_progress. Call with the GIL held. Returns -1 with the
+ * callback's exception set if it raised. */
+static int end_progress(ScsPyProgress *p) {
+  scs_py_progress_set(p->prev);
+  Py_CLEAR(p->callback);
+  scs_free(p->trace);
+  p->trace = NULL;
+  if (p->exc) {
+    PyErr_SetRaisedException(p->exc);
+    p->exc = NULL;
+    return -1;
+  }
+  return 0;
+}
+
+static PyObject *SCS_solve(SCS *self, PyObject *args) {
+  ScsInfo info = {0};
+  ScsSolution *sol = self->sol;
+
+  PyArrayObject *warm_x, *warm_y, *warm_s;
+  PyObject *warm_start;
+  PyObject *out_x = Py_None, *out_y = Py_None, *out_s = Py_None;
+  PyObject *lite_info = NULL;
+  PyObject *stop = Py_None;
+  Py_buffer stop_view = {0};
+
+  /* clang-format off */
+  /* warm_* and out_* can be None, so don't check is PyArray_Type */
+  if (!PyArg_ParseTuple(args, "O!OOO|OOOO!O",
+                        &PyBool_Type, &warm_start,
+                        &warm_x,
+                        &warm_y,
+                        &warm_s,
+                        &out_x,
+                        &out_y,
+                        &out_s,
+                        &PyBool_Type, &lite_info,
+                        &stop)) {
+    /* PyArg_ParseTuple already set an informative TypeError; propagate it. */
+    return (PyObject *)NULL;
+  }
+  /* clang-format on */
+
+  scs_int _warm_start = (scs_int)PyObject_IsTrue(warm_start);
+  int _lite_info = lite_info ? PyObject_IsTrue(lite_info) : 0;
+
+  if ((!Py_IsNone(out_x) && check_out_buffer(out_x, self->n, "out_x") < 0) ||
+      (!Py_IsNone(out_y) && check_out_buffer(out_y, self->m, "out_y") < 0) ||
+      (!Py_IsNone(out_s) && check_out_buffer(out_s, self->m, "out_s") < 0) ||
+      check_out_disjoint(out_x, "out_x", out_y, "out_y") < 0 ||
+      check_out_disjoint(out_x, "out_x", out_s, "out_s") < 0 ||
+      check_out_disjoint(out_y, "out_y", out_s, "out_s") < 0) {
+    return NULL;
+  }
+
+  /* Acquire per-instance lock. Release the GIL first to avoid deadlock:
+   * another thread may hold this lock inside scs_solve (with GIL released),
+   * so we must not hold the GIL while waiting for the lock. */
+  int lock_ok = lock_instance(self);
+
+  if (!lock_ok) {
+    return none_with_error("Failed to acquire instance lock");
+  }
+
+  /* Check workspace under lock to avoid TOCTOU race with SCS_finish */
+  if (!self->work) {
+    PyThread_release_lock(self->lock);
+    return none_with_error("Workspace not initialized!");
+  }
+
+  if (_warm_start) {
+    /* If any of these of missing, we use the values in sol */
+    if (!Py_IsNone((PyObject *)warm_x)) {
+      if (get_warm_start(self->sol->x, self->n, warm_x) < 0) {
+        PyThread_release_lock(self->lock);
+        return none_with_error("Unable to parse x warm-start");
+      }
+    }
+    if (!Py_IsNone((PyObject *)warm_y)) {
+      if (get_warm_start(self->sol->y, self->m, warm_y) < 0) {
+        PyThread_release_lock(self->lock);
+        return none_with_error("Unable to parse y warm-start");
+      }
+    }
+    if (!Py_IsNone((PyObject *)warm_s)) {
+      if (get_warm_start(self->sol->s, self->m, warm_s) < 0) {
+        PyThread_release_lock(self->lock);
+        return none_with_error("Unable to parse s warm-start");
+      }
+    }
+  }
+  /* else: SCS will overwite sol if _warm_start is false */
+  /* so we don't need to set to zeros here */
+
+  PyObject *x, *y, *s, *return_dict, *info_dict, *aa_stats_dict = NULL;
+  PyObject *trace = NULL;
+  scs_float *_x = NULL, *_y = NULL, *_s = NULL;
+  int copy_ok, tracing, prev_threads;
+  ScsPyProgress progress;
+  /* `stop` is a writable buffer whose first byte another thread may set
+   * to end this solve at the next iteration (see SCS.solve_async). The
+   * buffer export keeps it from being resized while the core polls it. */
+  if (!Py_IsNone(stop)) {
+    if (PyObject_GetBuffer(stop, &stop_view, PyBUF_WRITABLE) < 0) {
+      PyThread_release_lock(self->lock);
+      return NULL;
+    }
+    if (stop_view.len < 1) {
+      PyBuffer_Release(&stop_view);
+      PyThread_release_lock(self->lock);
+      return none_with_error("stop must hold at least one byte");
+    }
+  }
+  if (begin_progress(self, &progress, 1) < 0) {
+    PyBuffer_Release(&stop_view); /* no-op if stop was None */
+    PyThread_release_lock(self->lock);
+    return NULL;
+  }
+  progress.stop = (const volatile char *)stop_view.buf;
+  tracing = progress.trace != NULL;
+  /* release the GIL */
+  Py_BEGIN_ALLOW_THREADS;
+  /* Solve! */
+  prev_threads = use_threads(self->num_threads);
+  scs_solve(self->work, sol, &info, _warm_start);
+  restore_threads(self->num_threads, prev_threads);
+  scs_py_progress_finish(&progress);
+  progress_mark_stopped(&progress, &info);
+
+  /* Copy results out of sol while still holding the lock, because another
+   * thread's solve could overwrite sol as soon as we release. sol itself
+   * has to stay library-owned: it is the warm-start for the next solve.
+   * Caller-provided out_* arrays receive the copy directly, so a solve
+   * loop that passes them allocates no solution vectors at all.
+   * Note: unlike SCS_update, we release the lock after Py_END_ALLOW_THREADS
+   * because we need to read from sol (shared state) under lock protection. */
+  copy_ok = copy_solution_vec(&_x, out_x, sol->x, self->n) == 0 &&
+            copy_solution_vec(&_y, out_y, sol->y, self->m) == 0 &&
+            copy_solution_vec(&_s, out_s, sol->s, self->m) == 0;
+  Py_END_ALLOW_THREADS;
+
+  PyThread_release_lock(self->lock);
+  PyBuffer_Release(&stop_view);
+
+  /* The trace ring is private to this call, so no lock is needed here. */
+  if (tracing) {
+    trace = progress_trace_array(&progress);
+  }
+  if (end_progress(&progress) < 0 || !copy_ok || (tracing && !trace)) {
+    scs_free(_x);
+    scs_free(_y);
+    scs_free(_s);
+    Py_XDECREF(trace);
+    return PyErr_Occurred() ? NULL : PyErr_NoMemory();
+  }
+
+  /* Build numpy arrays from the copied data (no longer under lock since
+   * these are thread-local copies). solution_vec_array frees its buffer on
+   * failure; the buffers of the arrays not built yet are freed here. */
+  x = solution_vec_array(_x, out_x, self->n);
+  if (!x) {
+    scs_free(_y);
+    scs_free(_s);
+    Py_XDECREF(trace);
+    return NULL;
+  }
+  y = solution_vec_array(_y, out_y, self->m);
+  if (!y) {
+    scs_free(_s);
+    Py_DECREF(x);
+    Py_XDECREF(trace);
+    return NULL;
+  }
+  s = solution_vec_array(_s, out_s, self->m);
+  if (!s) {
+    Py_DECREF(x);
+    Py_DECREF(y);
+    Py_XDECREF(trace);
+    return NULL;
+  }
+
+/* output arguments */
+/* Use 'L' (long long) for scs_int under DLONG to match scs_int's typedef
+ * (long long); 'l' (long) would truncate to 32 bits on LLP64 Windows.
+ * Mirrors the argparse_string choice in SCS_init. */
+#ifdef DLONG
+#ifdef SFLOAT
+  char *outarg_string = "{s:L,s:L,s:L,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,"
+                        "s:f,s:f,s:f,s:f,s:f,s:L,s:L,s:s}";
+  char *lite_outarg_string = "{s:L,s:L,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+  char *aa_stats_string = "{s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:f,s:f}";
+#else
+  char *outarg_string = "{s:L,s:L,s:L,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,"
+                        "s:d,s:d,s:d,s:d,s:d,s:L,s:L,s:s}";
+  char *lite_outarg_string = "{s:L,s:L,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+  char *aa_stats_string = "{s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:d,s:d}";
+#endif
+#else
+#ifdef SFLOAT
+  char *outarg_string = "{s:i,s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,"
+                        "s:f,s:f,s:f,s:f,s:f,s:i,s:i,s:s}";
+  char *lite_outarg_string = "{s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
   char *aa_stats_string = "{s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:f,s:f}";
 #else
   char *outarg_string = "{s:i,s:i,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,"
                         "s:d,s:d,s:d,s:d,s:d,s:i,s:i,s:s}";
+  char *lite_outarg_string = "{s:i,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
   char *aa_stats_string = "{s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:d,s:d}";
 #endif
 #endif
 
-  /* clang-format off */
-  /* if you add fields to this remember to update outarg_string */
-  info_dict = Py_BuildValue(
-      outarg_string,
-      "status_val", (scs_int)info.status_val,
-      "iter", (scs_int)info.iter,
-      "scale_updates", (scs_int)info.scale_updates,
-      "scale", (scs_float)info.scale,
-      "pobj", (scs_float)info.pobj,
-      "dobj", (scs_float)info.dobj,
-      "res_pri", (scs_float)info.res_pri,
-      "res_dual", (scs_float)info.res_dual,
-      "gap", (scs_float)info.gap,
-      "res_infeas", (scs_float)info.res_infeas,
-      "res_unbdd_a", (scs_float)info.res_unbdd_a,
-      "res_unbdd_p", (scs_float)info.res_unbdd_p,
-      "comp_slack", (scs_float)info.comp_slack,
-      "solve_time", (scs_float)(info.solve_time),
-      "setup_time", (scs_float)(info.setup_time),
-      "lin_sys_time", (scs_float)(info.lin_sys_time),
-      "cone_time", (scs_float)(info.cone_time),
-      "accel_time", (scs_float)(info.accel_time),
-      "rejected_accel_steps", (scs_int)info.rejected_accel_steps,
-      "accepted_accel_steps", (scs_int)info.accepted_accel_steps,
-      "status", info.status);
-  aa_stats_dict = Py_BuildValue(
-      aa_stats_string,
-      "iter", (scs_int)info.aa_stats.iter,
-      "n_accept", (scs_int)info.aa_stats.n_accept,
-      "n_reject_lapack", (scs_int)info.aa_stats.n_reject_lapack,
-      "n_reject_rank0", (scs_int)info.aa_stats.n_reject_rank0,
-      "n_reject_nonfinite", (scs_int)info.aa_stats.n_reject_nonfinite,
-      "n_reject_weight_cap", (scs_int)info.aa_stats.n_reject_weight_cap,
-      "n_safeguard_reject", (scs_int)info.aa_stats.n_safeguard_reject,
-      "last_rank", (scs_int)info.aa_stats.last_rank,
-      "last_aa_norm", (scs_float)info.aa_stats.last_aa_norm,
-      "last_regularization", (scs_float)info.aa_stats.last_regularization);
-  /* clang-format on */
+  if (_lite_info) {
+    /* clang-format off */
+    /* if you add fields to this remember to update lite_outarg_string */
+    info_dict = Py_BuildValue(
+        lite_outarg_string,
+        "status_val", (scs_int)info.status_val,
+        "iter", (scs_int)info.iter,
+        "pobj", (scs_float)info.pobj,
+        "dobj", (scs_float)info.dobj,
+        "res_pri", (scs_float)info.res_pri,
+        "res_dual", (scs_float)info.res_dual,
+        "gap", (scs_float)info.gap,
+        "solve_time", (scs_float)(info.solve_time),
+        "status", info.status);
+    /* clang-format on */
+    if (!info_dict) {
+      Py_DECREF(x);
+      Py_DECREF(y);
+      Py_DECREF(s);
+      Py_XDECREF(trace);
+      return NULL;
+    }
+  } else {
+    /* clang-format off */
+    /* if you add fields to this remember to update outarg_string */
+    info_dict = Py_BuildValue(
+        outarg_string,
+        "status_val", (scs_int)info.status_val,
+        "iter", (scs_int)info.iter,
+        "scale_updates", (scs_int)info.scale_updates,
+        "scale", (scs_float)info.scale,
+        "pobj", (scs_float)info.pobj,
+        "dobj", (scs_float)info.dobj,
+        "res_pri", (scs_float)info.res_pri,
+        "res_dual", (scs_float)info.res_dual,
+        "gap", (scs_float)info.gap,
+        "res_infeas", (scs_float)info.res_infeas,
+        "res_unbdd_a", (scs_float)info.res_unbdd_a,
+        "res_unbdd_p", (scs_float)info.res_unbdd_p,
+        "comp_slack", (scs_float)info.comp_slack,
+        "solve_time", (scs_float)(info.solve_time),
+        "setup_time", (scs_float)(info.setup_time),
+        "lin_sys_time", (scs_float)(info.lin_sys_time),
+        "cone_time", (scs_float)(info.cone_time),
+        "accel_time", (scs_float)(info.accel_time),
+        "rejected_accel_steps", (scs_int)info.rejected_accel_steps,
+        "accepted_accel_steps", (scs_int)info.accepted_accel_steps,
+        "status", info.status);
+    aa_stats_dict = Py_BuildValue(
+        aa_stats_string,
+        "iter", (scs_int)info.aa_stats.iter,
+        "n_accept", (scs_int)info.aa_stats.n_accept,
+        "n_reject_lapack", (scs_int)info.aa_stats.n_reject_lapack,
+        "n_reject_rank0", (scs_int)info.aa_stats.n_reject_rank0,
+        "n_reject_nonfinite", (scs_int)info.aa_stats.n_reject_nonfinite,
+        "n_reject_weight_cap", (scs_int)info.aa_stats.n_reject_weight_cap,
+        "n_safeguard_reject", (scs_int)info.aa_stats.n_safeguard_reject,
+        "last_rank", (scs_int)info.aa_stats.last_rank,
+        "last_aa_norm", (scs_float)info.aa_stats.last_aa_norm,
+        "last_regularization", (scs_float)info.aa_stats.last_regularization);
+    /* clang-format on */
+
+    if (!info_dict || !aa_stats_dict ||
+        PyDict_SetItemString(info_dict, "aa_stats", aa_stats_dict) < 0) {
+      Py_DECREF(x);
+      Py_DECREF(y);
+      Py_DECREF(s);
+      Py_XDECREF(info_dict);
+      Py_XDECREF(aa_stats_dict);
+      Py_XDECREF(trace);
+      return NULL;
+    }
+  }
+
+#ifdef SCS_PY_CG_STATS
+  if (!_lite_info) {
+    PyObject *cg_dict = progress_cg_dict(&progress);
+    int set_ok = cg_dict && PyDict_SetItemString(info_dict, "lin_sys_iters",
+                                                 cg_dict) == 0;
+    Py_XDECREF(cg_dict);
+    if (!set_ok) {
+      Py_DECREF(x);
+      Py_DECREF(y);
+      Py_DECREF(s);
+      Py_DECREF(info_dict);
+      Py_XDECREF(aa_stats_dict);
+      Py_XDECREF(trace);
+      return NULL;
+    }
+  }
+#endif
+
+  if (trace) {
+    int set_ok = PyDict_SetItemString(info_dict, "trace", trace) == 0;
+    Py_DECREF(trace);
+    if (!set_ok) {
+      Py_DECREF(x);
+      Py_DECREF(y);
+      Py_DECREF(s);
+      Py_DECREF(info_dict);
+      Py_XDECREF(aa_stats_dict);
+      return NULL;
+    }
+  }
+
+  return_dict = Py_BuildValue("{s:O,s:O,s:O,s:O}", "x", x, "y", y, "s", s,
+                              "info", info_dict);
+  /* Give up ownership to the return dictionary. x/y/s/info_dict are non-NULL
+   * here, and Py_BuildValue borrowed each with "O". */
+  Py_DECREF(x);
+  Py_DECREF(y);
+  Py_DECREF(s);
+  Py_DECREF(info_dict);
+  Py_XDECREF(aa_stats_dict);
+
+  return return_dict;
+}
+
+static PyObject *SCS_update(SCS *self, PyObject *args) {
+  /* data structures for arguments */
+
+  /* get the typenum for the primitive scs_float type */
+  int scs_float_type = scs_get_float_type();
+
+  PyArrayObject *b_in, *c_in;
+  /* Contiguous versions of the inputs (strong refs, possibly the inputs
+   * themselves: scs_update copies them) or NULL for None. */
+  PyArrayObject *b_contig = NULL, *c_contig = NULL;
+  PyArrayObject *old_b = NULL, *old_c = NULL;
+  scs_float *b = NULL, *c = NULL;
+
+  /* b, c can be None, so don't check is PyArray_Type */
+  if (!PyArg_ParseTuple(args, "OO", &b_in, &c_in)) {
+    /* PyArg_ParseTuple already set an informative TypeError; propagate it. */
+    return (PyObject *)NULL;
+  }
+  /* set c */
+  if (!Py_IsNone((PyObject *)c_in)) {
+    /* Parsed with 'O' (to allow None): must PyArray_Check before using
+     * PyArray_ISFLOAT/NDIM/DIM, which are UB on non-array objects. */
+    if (!PyArray_Check((PyObject *)c_in) || !PyArray_ISFLOAT(c_in) ||
+        PyArray_NDIM(c_in) != 1) {
+      return none_with_type_error(
+          "c_new must be a 1-D numpy array of floats");
+    }
+    if (PyArray_DIM(c_in, 0) != (npy_intp)self->n) {
+      return none_with_error("c_new has incompatible dimension with A");
+    }
+    c_contig = scs_get_contiguous(c_in, scs_float_type);
+    if (!c_contig) {
+      return NULL;  /* numpy set the exception */
+    }
+    c = (scs_float *)PyArray_DATA(c_contig);
+  }
+  /* set b */
+  if (!Py_IsNone((PyObject *)b_in)) {
+    /* Parsed with 'O' (to allow None): must PyArray_Check before using
+     * PyArray_ISFLOAT/NDIM/DIM, which are UB on non-array objects. */
+    if (!PyArray_Check((PyObject *)b_in) || !PyArray_ISFLOAT(b_in) ||
+        PyArray_NDIM(b_in) != 1) {
+      Py_XDECREF(c_contig);
+      return none_with_type_error(
+          "b_new must be a 1-D numpy array of floats");
+    }
+    if (PyArray_DIM(b_in, 0) != (npy_intp)self->m) {
+      Py_XDECREF(c_contig);
+      return none_with_error("b_new has incompatible dimension with A");
+    }
+    b_contig = scs_get_contiguous(b_in, scs_float_type);
+    if (!b_contig) {
+      Py_XDECREF(c_contig);
+      return NULL;
+    }
+    b = (scs_float *)PyArray_DATA(b_contig);
+  }
+
+  /* Acquire per-instance lock (release GIL first to avoid deadlock) */
+  int lock_ok = lock_instance(self);
+
+  if (!lock_ok) {
+    Py_XDECREF(b_contig);
+    Py_XDECREF(c_contig);
+    return none_with_error("Failed to acquire instance lock");
+  }
+
+  /* Check workspace under lock to avoid TOCTOU race with SCS_finish */
+  if (!self->work) {
+    PyThread_release_lock(self->lock);
+    Py_XDECREF(b_contig);
+    Py_XDECREF(c_contig);
+    return none_with_error("Workspace not initialized!");
+  }
+
+  /* Release the GIL, run the update, then release the instance lock before
+   * re-acquiring the GIL. This avoids holding the instance lock while
+   * waiting for the GIL, which could deadlock if another GIL-holding thread
+   * is waiting on this lock. SCS_solve uses a different order (release lock
+   * after Py_END_ALLOW_THREADS) because it must copy results out of sol
+   * while still holding the lock. */
+  Py_BEGIN_ALLOW_THREADS;
+  scs_update(self->work, b, c);
+  if (b) {
+    old_b = drop_scratch_vector(&self->b);
+  }
+  if (c) {
+    old_c = drop_scratch_vector(&self->c);
+  }
+  PyThread_release_lock(self->lock);
+  Py_END_ALLOW_THREADS;
+
+  Py_XDECREF(old_b);
+  Py_XDECREF(old_c);
+  Py_XDECREF(b_contig);
+  Py_XDECREF(c_contig);
+
+  Py_RETURN_NONE;
+}
+
+/* Validate a sparse update of a length-`len` vector: integer indices in
+ * [0, len) and as many float values. On success *idx (npy_intp) and *val
+ * (scs_float) are contiguous new references; on failure both are NULL and
+ * a Python exception is set. */
+static int get_vector_entries(PyArrayObject *idx_in, PyArrayObject *val_in,
+                              scs_int len, const char *name,
+                              PyArrayObject **idx, PyArrayObject **val) {
+  npy_intp i, cnt;
+  const npy_intp *ix;
+  *idx = *val = NULL;
+  if (!PyArray_Check((PyObject *)idx_in) || !PyArray_ISINTEGER(idx_in) ||
+      PyArray_NDIM(idx_in) != 1) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s_idx must be a 1-D numpy array of integers", name);
+    return -1;
+  }
+  if (!PyArray_Check((PyObject *)val_in) || !PyArray_ISFLOAT(val_in) ||
+      PyArray_NDIM(val_in) != 1) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s_val must be a 1-D numpy array of floats", name);
+    return -1;
+  }
+  cnt = PyArray_DIM(idx_in, 0);
+  if (PyArray_DIM(val_in, 0) != cnt) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s_idx and %s_val must have the same length", name, name);
+    return -1;
+  }
+  *idx = scs_get_contiguous(idx_in, NPY_INTP);
+  if (!*idx) {
+    return -1;
+  }
+  ix = (const npy_intp *)PyArray_DATA(*idx);
+  for (i = 0; i < cnt; ++i) {
+    if (ix[i] < 0 || ix[i] >= (npy_intp)len) {
+      PyErr_Format(PyExc_IndexError, "%s_idx entry %ld is out of range [0, %ld)",
+                   name, (long)ix[i], (long)len);
+      Py_CLEAR(*idx);
+      return -1;
+    }
+  }
+  *val = scs_get_contiguous(val_in, scs_get_float_type());
+  if (!*val) {
+    Py_CLEAR(*idx);
+    return -1;
+  }
+  return 0;
+}
+
+/* Write the (validated) sparse update idx/val into v; later entries win
+ * for repeated indices. Needs no GIL. */
+static void scatter_entries(scs_float *v, PyArrayObject *idx,
+                            PyArrayObject *val) {
+  npy_intp i, cnt = PyArray_DIM(idx, 0);
+  const npy_intp *ix = (const npy_intp *)PyArray_DATA(idx);
+  const scs_float *vx = (const scs_float *)PyArray_DATA(val);
+  for (i = 0; i < cnt; ++i) {
+    v[ix[i]] = vx[i];
+  }
+}
+
+/* Validate a whole new b or c of length `len` and return it as a contiguous
+ * scs_float array (new reference, possibly `in` itself), or NULL with a
+ * Python exception set. */
+static PyArrayObject *get_whole_vector(PyArrayObject *in, scs_int len,
+                                       const char *name) {
+  if (!PyArray_Check((PyObject *)in) || !PyArray_ISFLOAT(in) ||
+      PyArray_NDIM(in) != 1) {
+    PyErr_Format(PyExc_TypeError, "%s must be a 1-D numpy array of floats",
+                 name);
+    return NULL;
+  }
+  if (PyArray_DIM(in, 0) != (npy_intp)len) {
+    PyErr_Format(PyExc_ValueError, "%s has incompatible dimension with A",
+                 name);
+    return NULL;
+  }
+  return scs_get_contiguous(in, scs_get_float_type());
+}
+
+/* Parse one of b or c for _update_entries: entries (idx and val), the
+ * whole vector (idx None, val the vector; returned in *val with *idx
+ * NULL), or nothing (both None). */
+static int get_update_arg(PyArrayObject *idx_in, PyArrayObject *val_in,
+                          scs_int len, const char *name, PyArrayObject **idx,
+                          PyArrayObject **val) {
+  *idx = *val = NULL;
+  if (!Py_IsNone((PyObject *)idx_in)) {
+    return get_vector_entries(idx_in, val_in, len, name, idx, val);
+  }
+  if (!Py_IsNone((PyObject *)val_in)) {
+    *val = get_whole_vector(val_in, len, name);
+    return *val ? 0 : -1;
+  }
+  return 0;
+}
+
+/* Make sure *scratch holds a copy of the workspace's current b or c
+ * (`cur`, of length len), as partial updates need. Needs the instance
+ * lock and the GIL. Returns -1 with a Python exception set on failure. */
+static int get_scratch_vector(PyArrayObject **scratch, const scs_float *cur,
+                              scs_int len) {
+  npy_intp dims[1];
+  if (*scratch) {
+    return 0;
+  }
+  dims[0] = len;
+  *scratch = (PyArrayObject *)PyArray_SimpleNew(1, dims, scs_get_float_type());
+  if (!*scratch) {
+    return -1;
+  }
+  memcpy(PyArray_DATA(*scratch), cur, len * sizeof(scs_float));
+  return 0;
+}
+
+/* Apply one of b or c parsed by get_update_arg: scatter the entries into
+ * the scratch vector, or drop it when the vector is replaced whole (the
+ * dropped one is returned in *old for the caller to release with the
+ * GIL). Returns what to pass to scs_update for it. Needs the instance lock
+ * but not the GIL. */
+static scs_float *apply_update_arg(PyArrayObject **scratch,
+                                   PyArrayObject *idx, PyArrayObject *val,
+                                   PyArrayObject **old) {
+  if (idx) {
+    scatter_entries((scs_float *)PyArray_DATA(*scratch), idx, val);
+    return (scs_float *)PyArray_DATA(*scratch);
+  }
+  if (val) {
+    *old = drop_scratch_vector(scratch);
+    return (scs_float *)PyArray_DATA(val);
+  }
+  return NULL;
+}
+
+/* update() with only some entries of b and/or c: the new values are
+ * scattered into scratch copies of the current b and c, which then go to
+ * scs_update, so no full-length vector is built or converted on the Python
+ * side. The copies are made on the first such update (see the SCS struct).
+ * scs_update itself still copies (and rescales) the whole of each vector it
+ * is given, so this is O(m + n) in the core. Either vector may instead be
+ * replaced whole (idx None), so a mixed update is validated in full before
+ * any of it is applied. */
+static PyObject *SCS_update_entries(SCS *self, PyObject *args) {
+  PyArrayObject *b_idx_in, *b_val_in, *c_idx_in, *c_val_in;
+  PyArrayObject *b_idx = NULL, *b_val = NULL, *c_idx = NULL, *c_val = NULL;
+  PyArrayObject *old_b = NULL, *old_c = NULL;
+  scs_float *b, *c;
+  int lock_ok;
+
+  /* all can be None, so don't check is PyArray_Type */
+  if (!PyArg_ParseTuple(args, "OOOO", &b_idx_in, &b_val_in, &c_idx_in,
+                        &c_val_in)) {
+    return (PyObject *)NULL;
+  }
+  if (get_update_arg(b_idx_in, b_val_in, self->m, "b", &b_idx, &b_val) < 0 ||
+      get_update_arg(c_idx_in, c_val_in, self->n, "c", &c_idx, &c_val) < 0) {
+    Py_XDECREF(b_idx);
+    Py_XDECREF(b_val);
+    return NULL;
+  }
 
-  if (!info_dict || !aa_stats_dict ||
-      PyDict_SetItemString(info_dict, "aa_stats", aa_stats_dict) < 0) {
-    Py_DECREF(x);
-    Py_DECREF(y);
-    Py_DECREF(s);
-    Py_XDECREF(info_dict);
-    Py_XDECREF(aa_stats_dict);
+  /* Acquire per-instance lock (release GIL first to avoid deadlock) */
+  lock_ok = lock_instance(self);
+
+  if (!lock_ok || !self->work) {
+    if (lock_ok) {
+      PyThread_release_lock(self->lock);
+    }
+    Py_XDECREF(b_idx);
+    Py_XDECREF(b_val);
+    Py_XDECREF(c_idx);
+    Py_XDECREF(c_val);
+    return none_with_error(lock_ok ? "Workspace not initialized!"
+                                   : "Failed to acquire instance lock");
+  }
+
+  if ((b_idx &&
+       get_scratch_vector(&self->b, scs_py_work_b(self->work), self->m) < 0) ||
+      (c_idx &&
+       get_scratch_vector(&self->c, scs_py_work_c(self->work), self->n) < 0)) {
+    PyThread_release_lock(self->lock);
+    Py_XDECREF(b_idx);
+    Py_XDECREF(b_val);
+    Py_XDECREF(c_idx);
+    Py_XDECREF(c_val);
     return NULL;
   }
 
-  return_dict = Py_BuildValue("{s:O,s:O,s:O,s:O}", "x", x, "y", y, "s", s,
-                              "info", info_dict);
-  /* Give up ownership to the return dictionary. x/y/s/info_dict are non-NULL
-   * here, and Py_BuildValue borrowed each with "O". */
-  Py_DECREF(x);
-  Py_DECREF(y);
-  Py_DECREF(s);
-  Py_DECREF(info_dict);
-  Py_DECREF(aa_stats_dict);
+  /* Same lock/GIL order as SCS_update. */
+  Py_BEGIN_ALLOW_THREADS;
+  b = apply_update_arg(&self->b, b_idx, b_val, &old_b);
+  c = apply_update_arg(&self->c, c_idx, c_val, &old_c);
+  if (b || c) {
+    scs_update(self->work, b, c);
+  }
+  PyThread_release_lock(self->lock);
+  Py_END_ALLOW_THREADS;
 
-  return return_dict;
-}
+  Py_XDECREF(old_b);
+  Py_XDECREF(old_c);
+  Py_XDECREF(b_idx);
+  Py_XDECREF(b_val);
+  Py_XDECREF(c_idx);
+  Py_XDECREF(c_val);
 
-static PyObject *SCS_update(SCS *self, PyObject *args) {
-  /* data structures for arguments */
+  Py_RETURN_NONE;
+}
 
-  /* get the typenum for the primitive scs_float type */
-  int scs_float_type = scs_get_float_type();
+/* Validate new nonzero values for a retained matrix and return them as a
+ * contiguous scs_float array of our own (new reference, see
+ * own_matrices), or NULL with a Python exception set. */
+static PyArrayObject *get_matrix_values(PyArrayObject *in, const ScsMatrix *M,
+                                        const char *name) {
+  scs_int nnz = M->p[M->n];
+  PyArrayObject *out;
+  if (!PyArray_Check((PyObject *)in) || !PyArray_ISFLOAT(in) ||
+      PyArray_NDIM(in) != 1) {
+    PyErr_Format(PyExc_TypeError, "%s must be a 1-D numpy array of floats",
+                 name);
+    return NULL;
+  }
+  if (PyArray_DIM(in, 0) != (npy_intp)nnz) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s must have %ld entries, one per stored nonzero", name,
+                 (long)nnz);
+    return NULL;
+  }
+  out = scs_get_contiguous(in, scs_get_float_type());
+  if (out == in && own_copy(&out) < 0) {
+    return NULL;
+  }
+  return out;
+}
 
-  PyArrayObject *b_in, *c_in;
-  /* Contiguous copies we own (strong refs) or NULL when the corresponding
-   * input was None or we haven't made a copy yet. */
-  PyArrayObject *b_contig = NULL, *c_contig = NULL;
-  scs_float *b = NULL, *c = NULL;
+static PyObject *SCS_update_matrices(SCS *self, PyObject *args) {
+  PyArrayObject *Ax_in, *Px_in;
+  PyArrayObject *Ax = NULL, *Px = NULL;
+  ScsMatrix A, P;
+  ScsData d;
+  ScsWork *work;
+  int lock_ok, prev_threads;
 
-  /* b, c can be None, so don't check is PyArray_Type */
-  if (!PyArg_ParseTuple(args, "OO", &b_in, &c_in)) {
-    /* PyArg_ParseTuple already set an informative TypeError; propagate it. */
+  /* Ax, Px can be None, so don't check is PyArray_Type */
+  if (!PyArg_ParseTuple(args, "OO", &Ax_in, &Px_in)) {
     return (PyObject *)NULL;
   }
-  /* set c */
-  if (!Py_IsNone((PyObject *)c_in)) {
-    /* Parsed with 'O' (to allow None): must PyArray_Check before using
-     * PyArray_ISFLOAT/NDIM/DIM, which are UB on non-array objects. */
-    if (!PyArray_Check((PyObject *)c_in) || !PyArray_ISFLOAT(c_in) ||
-        PyArray_NDIM(c_in) != 1) {
-      return none_with_type_error(
-          "c_new must be a 1-D numpy array of floats");
+
+  /* Take the lock first: the retained patterns we validate against are
+   * only stable while we hold it. */
+  lock_ok = lock_instance(self);
+
+  if (!lock_ok) {
+    return none_with_error("Failed to acquire instance lock");
+  }
+
+  if (!self->work) {
+    PyThread_release_lock(self->lock);
+    return none_with_error("Workspace not initialized!");
+  }
+  if (!self->d) {
+    PyThread_release_lock(self->lock);
+    return none_with_error("update_matrices needs the keep_problem setting");
+  }
+
+  if (!Py_IsNone((PyObject *)Ax_in)) {
+    Ax = get_matrix_values(Ax_in, self->d->A, "Ax");
+    if (!Ax) {
+      PyThread_release_lock(self->lock);
+      return NULL;
     }
-    if (PyArray_DIM(c_in, 0) != (npy_intp)self->n) {
-      return none_with_error("c_new has incompatible dimension with A");
+  }
+  if (!Py_IsNone((PyObject *)Px_in)) {
+    if (!self->d->P) {
+      PyThread_release_lock(self->lock);
+      Py_XDECREF(Ax);
+      return none_with_error("Px given but the problem has no P matrix");
     }
-    c_contig = scs_get_contiguous(c_in, scs_float_type);
-    if (!c_contig) {
-      return NULL;  /* numpy set the exception */
+    Px = get_matrix_values(Px_in, self->d->P, "Px");
+    if (!Px) {
+      PyThread_release_lock(self->lock);
+      Py_XDECREF(Ax);
+      return NULL;
     }
-    c = (scs_float *)PyArray_DATA(c_contig);
   }
-  /* set b */
-  if (!Py_IsNone((PyObject *)b_in)) {
-    /* Parsed with 'O' (to allow None): must PyArray_Check before using
-     * PyArray_ISFLOAT/NDIM/DIM, which are UB on non-array objects. */
-    if (!PyArray_Check((PyObject *)b_in) || !PyArray_ISFLOAT(b_in) ||
-        PyArray_NDIM(b_in) != 1) {
-      Py_XDECREF(c_contig);
-      return none_with_type_error(
-          "b_new must be a 1-D numpy array of floats");
+
+  /* Same problem with the new values swapped in. The patterns, cone and
+   * settings are the retained, already validated ones, b and c the current
+   * ones of the workspace, which scs_init only reads. */
+  d = *self->d;
+  d.b = (scs_float *)scs_py_work_b(self->work);
+  d.c = (scs_float *)scs_py_work_c(self->work);
+  A = *self->d->A;
+  d.A = &A;
+  if (Ax) {
+    A.x = (scs_float *)PyArray_DATA(Ax);
+  }
+  if (self->d->P) {
+    P = *self->d->P;
+    d.P = &P;
+    if (Px) {
+      P.x = (scs_float *)PyArray_DATA(Px);
     }
-    if (PyArray_DIM(b_in, 0) != (npy_intp)self->m) {
-      Py_XDECREF(c_contig);
-      return none_with_error("b_new has incompatible dimension with A");
+  }
+
+  /* The public SCS API has no numeric-only refactorization, so this builds
+   * a fresh workspace. The old one stays in place if that fails. */
+  Py_BEGIN_ALLOW_THREADS;
+  prev_threads = use_threads(self->num_threads);
+  work = scs_init(&d, self->k, self->stgs);
+  restore_threads(self->num_threads, prev_threads);
+  if (work) {
+    scs_finish(self->work);
+    self->work = work;
+  }
+  Py_END_ALLOW_THREADS;
+
+  if (work) {
+    /* Keep the new values as the retained ones (drops our reference to the
+     * old arrays); the solution in self->sol stays as the warm-start. */
+    if (Ax) {
+      Py_SETREF(self->ps.Ax, Ax);
+      self->d->A->x = (scs_float *)PyArray_DATA(Ax);
+      Ax = NULL;
     }
-    b_contig = scs_get_contiguous(b_in, scs_float_type);
-    if (!b_contig) {
-      Py_XDECREF(c_contig);
-      return NULL;
+    if (Px) {
+      Py_SETREF(self->ps.Px, Px);
+      self->d->P->x = (scs_float *)PyArray_DATA(Px);
+      Px = NULL;
     }
-    b = (scs_float *)PyArray_DATA(b_contig);
   }
+  PyThread_release_lock(self->lock);
+
+  Py_XDECREF(Ax);
+  Py_XDECREF(Px);
+  if (!work) {
+    return none_with_error("ScsWork allocation error!");
+  }
+  Py_RETURN_NONE;
+}
+
+/* One record of the structured `info` array returned by solve_batch. The
+ * numpy dtype built from scs_batch_info_fields mirrors this layout field for
+ * field (offsets come from offsetof), so the solve loop can fill records
+ * with plain C stores while the GIL is released. */
+typedef struct {
+  scs_int status_val;
+  scs_int iter;
+  scs_int scale_updates;
+  scs_float scale;
+  scs_float pobj;
+  scs_float dobj;
+  scs_float res_pri;
+  scs_float res_dual;
+  scs_float gap;
+  scs_float res_infeas;
+  scs_float res_unbdd_a;
+  scs_float res_unbdd_p;
+  scs_float comp_slack;
+  scs_float solve_time;
+  scs_float setup_time;
+  scs_float lin_sys_time;
+  scs_float cone_time;
+  scs_float accel_time;
+  scs_int rejected_accel_steps;
+  scs_int accepted_accel_steps;
+} ScsPyBatchInfo;
+
+#define SCS_BATCH_INT_FIELD(name)                                              \
+  { #name, offsetof(ScsPyBatchInfo, name), 1 }
+#define SCS_BATCH_FLOAT_FIELD(name)                                            \
+  { #name, offsetof(ScsPyBatchInfo, name), 0 }
+
+static const ScsPyField scs_batch_info_fields[] = {
+    SCS_BATCH_INT_FIELD(status_val),
+    SCS_BATCH_INT_FIELD(iter),
+    SCS_BATCH_INT_FIELD(scale_updates),
+    SCS_BATCH_FLOAT_FIELD(scale),
+    SCS_BATCH_FLOAT_FIELD(pobj),
+    SCS_BATCH_FLOAT_FIELD(dobj),
+    SCS_BATCH_FLOAT_FIELD(res_pri),
+    SCS_BATCH_FLOAT_FIELD(res_dual),
+    SCS_BATCH_FLOAT_FIELD(gap),
+    SCS_BATCH_FLOAT_FIELD(res_infeas),
+    SCS_BATCH_FLOAT_FIELD(res_unbdd_a),
+    SCS_BATCH_FLOAT_FIELD(res_unbdd_p),
+    SCS_BATCH_FLOAT_FIELD(comp_slack),
+    SCS_BATCH_FLOAT_FIELD(solve_time),
+    SCS_BATCH_FLOAT_FIELD(setup_time),
+    SCS_BATCH_FLOAT_FIELD(lin_sys_time),
+    SCS_BATCH_FLOAT_FIELD(cone_time),
+    SCS_BATCH_FLOAT_FIELD(accel_time),
+    SCS_BATCH_INT_FIELD(rejected_accel_steps),
+    SCS_BATCH_INT_FIELD(accepted_accel_steps),
+};
+
+#undef SCS_BATCH_INT_FIELD
+#undef SCS_BATCH_FLOAT_FIELD
+
+static void scs_fill_batch_info(ScsPyBatchInfo *out, const ScsInfo *info) {
+  out->status_val = info->status_val;
+  out->iter = info->iter;
+  out->scale_updates = info->scale_updates;
+  out->scale = info->scale;
+  out->pobj = info->pobj;
+  out->dobj = info->dobj;
+  out->res_pri = info->res_pri;
+  out->res_dual = info->res_dual;
+  out->gap = info->gap;
+  out->res_infeas = info->res_infeas;
+  out->res_unbdd_a = info->res_unbdd_a;
+  out->res_unbdd_p = info->res_unbdd_p;
+  out->comp_slack = info->comp_slack;
+  out->solve_time = info->solve_time;
+  out->setup_time = info->setup_time;
+  out->lin_sys_time = info->lin_sys_time;
+  out->cone_time = info->cone_time;
+  out->accel_time = info->accel_time;
+  out->rejected_accel_steps = info->rejected_accel_steps;
+  out->accepted_accel_steps = info->accepted_accel_steps;
+}
+
+/* Validate one of the stacked (k x len) right-hand sides passed to
+ * solve_batch. On success *out holds a C-contiguous strong reference (or
+ * stays NULL when the input was None) and *k is set from the row count if
+ * it was still unknown (-1). Sets a Python exception and returns -1 on
+ * failure. */
+static int get_batch_rhs(PyArrayObject *in, npy_intp len, const char *name,
+                         npy_intp *k, PyArrayObject **out) {
+  *out = NULL;
+  if (Py_IsNone((PyObject *)in)) {
+    return 0;
+  }
+  if (!PyArray_Check((PyObject *)in) || !PyArray_ISFLOAT(in) ||
+      PyArray_NDIM(in) != 2) {
+    PyErr_Format(PyExc_TypeError, "%s must be a 2-D numpy array of floats",
+                 name);
+    return -1;
+  }
+  if (PyArray_DIM(in, 1) != len) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s must have %ld columns (one row per solve)", name,
+                 (long)len);
+    return -1;
+  }
+  if (*k >= 0 && PyArray_DIM(in, 0) != *k) {
+    PyErr_SetString(PyExc_ValueError,
+                    "b and c batches must have the same number of rows");
+    return -1;
+  }
+  *k = PyArray_DIM(in, 0);
+  *out = scs_get_contiguous(in, scs_get_float_type());
+  return *out ? 0 : -1;
+}
+
+static PyObject *SCS_solve_batch(SCS *self, PyObject *args) {
+  int scs_float_type = scs_get_float_type();
+  PyArrayObject *b_in, *c_in;
+  PyArrayObject *b_contig = NULL, *c_contig = NULL;
+  PyArrayObject *old_b = NULL, *old_c = NULL;
+  PyObject *warm_start;
+  PyObject *x = NULL, *y = NULL, *s = NULL, *info_arr = NULL;
+  PyArray_Descr *descr;
+  npy_intp i, k = -1, dims[2];
+  int lock_ok, prev_threads;
+
+  /* b, c can be None, so don't check is PyArray_Type */
+  if (!PyArg_ParseTuple(args, "OOO!", &b_in, &c_in, &PyBool_Type,
+                        &warm_start)) {
+    return (PyObject *)NULL;
+  }
+  scs_int _warm_start = (scs_int)PyObject_IsTrue(warm_start);
 
+  if (get_batch_rhs(b_in, (npy_intp)self->m, "b", &k, &b_contig) < 0) {
+    return NULL;
+  }
+  if (get_batch_rhs(c_in, (npy_intp)self->n, "c", &k, &c_contig) < 0) {
+    Py_XDECREF(b_contig);
+    return NULL;
+  }
+  if (k < 0) {
+    return none_with_error("At least one of b or c must be given");
+  }
+
+  /* Allocate every output up front so the solve loop below never needs the
+   * GIL; results are written straight into these arrays. */
+  dims[0] = k;
+  dims[1] = (npy_intp)self->n;
+  x = PyArray_SimpleNew(2, dims, scs_float_type);
+  dims[1] = (npy_intp)self->m;
+  y = PyArray_SimpleNew(2, dims, scs_float_type);
+  s = PyArray_SimpleNew(2, dims, scs_float_type);
+  descr = scs_struct_descr(scs_batch_info_fields,
+                           SCS_NUM_FIELDS(scs_batch_info_fields),
+                           sizeof(ScsPyBatchInfo));
+  if (descr) {
+    /* PyArray_NewFromDescr steals the reference to descr */
+    info_arr = PyArray_NewFromDescr(&PyArray_Type, descr, 1, dims, NULL, NULL,
+                                    0, NULL);
+  }
+  if (!x || !y || !s || !info_arr) {
+    goto fail;
+  }
   /* Acquire per-instance lock (release GIL first to avoid deadlock) */
-  int lock_ok;
-  Py_BEGIN_ALLOW_THREADS;
-  lock_ok = (PyThread_acquire_lock(self->lock, WAIT_LOCK) == PY_LOCK_ACQUIRED);
-  Py_END_ALLOW_THREADS;
+  lock_ok = lock_instance(self);
 
   if (!lock_ok) {
-    Py_XDECREF(b_contig);
-    Py_XDECREF(c_contig);
-    return none_with_error("Failed to acquire instance lock");
+    none_with_error("Failed to acquire instance lock");
+    goto fail;
   }
 
   /* Check workspace under lock to avoid TOCTOU race with SCS_finish */
   if (!self->work) {
     PyThread_release_lock(self->lock);
-    Py_XDECREF(b_contig);
-    Py_XDECREF(c_contig);
-    return none_with_error("Workspace not initialized!");
+    none_with_error("Workspace not initialized!");
+    goto fail;
   }
 
-  /* Release the GIL, run the update, then release the instance lock before
-   * re-acquiring the GIL. This avoids holding the instance lock while
-   * waiting for the GIL, which could deadlock if another GIL-holding thread
-   * is waiting on this lock. SCS_solve uses a different order (release lock
-   * after Py_END_ALLOW_THREADS) because it must copy results out of sol
-   * while still holding the lock. */
-  Py_BEGIN_ALLOW_THREADS;
-  scs_update(self->work, b, c);
-  PyThread_release_lock(self->lock);
-  Py_END_ALLOW_THREADS;
+  {
+    scs_float *b = b_contig ? (scs_float *)PyArray_DATA(b_contig) : NULL;
+    scs_float *c = c_contig ? (scs_float *)PyArray_DATA(c_contig) : NULL;
+    scs_float *xo = (scs_float *)PyArray_DATA((PyArrayObject *)x);
+    scs_float *yo = (scs_float *)PyArray_DATA((PyArrayObject *)y);
+    scs_float *so = (scs_float *)PyArray_DATA((PyArrayObject *)s);
+    ScsPyBatchInfo *io =
+        (ScsPyBatchInfo *)PyArray_DATA((PyArrayObject *)info_arr);
+    scs_int m = self->m, n = self->n;
+    ScsPyProgress progress;
+
+    npy_intp j, ran = k;
+
+    /* Every solve runs against the one workspace (and its factorization).
+     * Solve i warm-starts from solve i - 1 when warm_start is set, which is
+     * what parameter sweeps over nearby (b, c) want. As with SCS_update, the
+     * lock is released before re-acquiring the GIL since nothing shared is
+     * read afterwards. A progress callback that stops (or raises) ends the
+     * batch: that solve returns as interrupted, with its last iterate, and
+     * the solves after it are not run. */
+    if (begin_progress(self, &progress, 0) < 0) {
+      PyThread_release_lock(self->lock);
+      goto fail;
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    prev_threads = use_threads(self->num_threads);
+    for (i = 0; i < k; ++i) {
+      ScsInfo info = {0};
+      scs_update(self->work, b ? b + i * m : NULL, c ? c + i * n : NULL);
+      scs_solve(self->work, self->sol, &info, _warm_start);
+      scs_py_progress_finish(&progress);
+      progress_mark_stopped(&progress, &info);
+      memcpy(xo + i * n, self->sol->x, n * sizeof(scs_float));
+      memcpy(yo + i * m, self->sol->y, m * sizeof(scs_float));
+      memcpy(so + i * m, self->sol->s, m * sizeof(scs_float));
+      scs_fill_batch_info(io + i, &info);
+      if (progress.stopped) {
+        ran = i + 1;
+        break;
+      }
+    }
+    restore_threads(self->num_threads, prev_threads);
+    /* Solves that were not run: NaN solutions and an all-zero info row
+     * (status_val SCS_UNFINISHED, iter 0). The workspace keeps the b and
+     * c of the last solve that ran; batched ones replace the scratch
+     * vectors of partial updates (see the SCS struct). */
+    for (j = ran * n; j < k * n; ++j) {
+      xo[j] = NAN;
+    }
+    for (j = ran * m; j < k * m; ++j) {
+      yo[j] = so[j] = NAN;
+    }
+    if (ran < k) {
+      memset(io + ran, 0, (k - ran) * sizeof(ScsPyBatchInfo));
+    }
+    if (b && ran > 0) {
+      old_b = drop_scratch_vector(&self->b);
+    }
+    if (c && ran > 0) {
+      old_c = drop_scratch_vector(&self->c);
+    }
+    PyThread_release_lock(self->lock);
+    Py_END_ALLOW_THREADS;
+    Py_XDECREF(old_b);
+    Py_XDECREF(old_c);
+    if (end_progress(&progress) < 0) {
+      goto fail;
+    }
+  }
+
+  Py_XDECREF(b_contig);
+  Py_XDECREF(c_contig);
+
+  {
+    PyObject *return_dict = Py_BuildValue("{s:O,s:O,s:O,s:O}", "x", x, "y", y,
+                                          "s", s, "info", info_arr);
+    Py_DECREF(x);
+    Py_DECREF(y);
+    Py_DECREF(s);
+    Py_DECREF(info_arr);
+    return return_dict;
+  }
 
+fail:
   Py_XDECREF(b_contig);
   Py_XDECREF(c_contig);
+  Py_XDECREF(x);
+  Py_XDECREF(y);
+  Py_XDECREF(s);
+  Py_XDECREF(info_arr);
+  return NULL;
+}
+
+/* Set (or clear, with None) the progress callback and its interval. */
+static PyObject *SCS_set_callback(SCS *self, PyObject *args) {
+  PyObject *callback, *old;
+  scs_int interval;
+  int lock_ok;
+
+#ifdef DLONG
+  if (!PyArg_ParseTuple(args, "OL", &callback, &interval)) {
+#else
+  if (!PyArg_ParseTuple(args, "Oi", &callback, &interval)) {
+#endif
+    return (PyObject *)NULL;
+  }
+  if (!Py_IsNone(callback) && !PyCallable_Check(callback)) {
+    PyErr_SetString(PyExc_TypeError, "callback must be callable or None");
+    return NULL;
+  }
+  if (interval < 1) {
+    PyErr_SetString(PyExc_ValueError, "callback_interval must be positive");
+    return NULL;
+  }
+  lock_ok = lock_instance(self);
+  if (!lock_ok) {
+    return none_with_error("Failed to acquire instance lock");
+  }
+  old = self->callback;
+  self->callback = Py_IsNone(callback) ? NULL : Py_NewRef(callback);
+  self->callback_interval = interval;
+  PyThread_release_lock(self->lock);
+  Py_XDECREF(old);
+  Py_RETURN_NONE;
+}
+
+/* Enable (stride > 0) or disable the convergence trace of later solves. */
+static PyObject *SCS_set_trace(SCS *self, PyObject *args) {
+  scs_int stride, max_len;
+  int lock_ok;
 
+#ifdef DLONG
+  if (!PyArg_ParseTuple(args, "LL", &stride, &max_len)) {
+#else
+  if (!PyArg_ParseTuple(args, "ii", &stride, &max_len)) {
+#endif
+    return (PyObject *)NULL;
+  }
+  if (stride < 0) {
+    PyErr_SetString(PyExc_ValueError, "trace_stride must be nonnegative");
+    return NULL;
+  }
+  if (max_len < 1) {
+    PyErr_SetString(PyExc_ValueError, "trace_max_len must be positive");
+    return NULL;
+  }
+  lock_ok = lock_instance(self);
+  if (!lock_ok) {
+    return none_with_error("Failed to acquire instance lock");
+  }
+  self->trace_stride = stride;
+  self->trace_cap = max_len;
+  PyThread_release_lock(self->lock);
   Py_RETURN_NONE;
 }
 
@@ -1254,17 +2810,151 @@ static void SCS_finish(SCS *self) {
     scs_free(self->sol);
     self->sol = NULL;
   }
+  Py_CLEAR(self->converted_inputs);
+  Py_CLEAR(self->callback);
+  free_retained_problem(self);
+  Py_CLEAR(self->b);
+  Py_CLEAR(self->c);
 
   Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
+/* Copy of a retained array, or None when the problem does not have it. */
+static PyObject *dump_array(PyArrayObject *arr) {
+  if (!arr) {
+    Py_RETURN_NONE;
+  }
+  return PyArray_NewCopy(arr, NPY_CORDER);
+}
+
+/* Copy of a float vector of length l owned by the workspace or problem. */
+static PyObject *dump_vec(const scs_float *v, scs_int l) {
+  npy_intp veclen[1];
+  PyObject *arr;
+  veclen[0] = l;
+  arr = PyArray_SimpleNew(1, veclen, scs_get_float_type());
+  if (arr && l > 0) {
+    memcpy(PyArray_DATA((PyArrayObject *)arr), v, l * sizeof(scs_float));
+  }
+  return arr;
+}
+
+/* Return copies of the retained problem and of the current warm-start as
+ * ((m, n), Ax, Ai, Ap, Px, Pi, Pp, b, c, x, y, s), the first nine in the
+ * order the constructor takes them. Taken under the instance lock so the
+ * result is consistent with concurrent update()/update_matrices(). */
+static PyObject *SCS_problem_dump(SCS *self, PyObject *Py_UNUSED(ignored)) {
+  PyObject *items[11] = {NULL};
+  PyObject *ret = NULL;
+  int lock_ok, i;
+
+  lock_ok = lock_instance(self);
+  if (!lock_ok) {
+    return none_with_error("Failed to acquire instance lock");
+  }
+  if (!self->work) {
+    PyThread_release_lock(self->lock);
+    return none_with_error("Workspace not initialized!");
+  }
+  if (!self->d) {
+    PyThread_release_lock(self->lock);
+    return none_with_error("save_problem needs the keep_problem setting");
+  }
+  items[0] = dump_array(self->ps.Ax);
+  items[1] = dump_array(self->ps.Ai);
+  items[2] = dump_array(self->ps.Ap);
+  items[3] = dump_array(self->ps.Px);
+  items[4] = dump_array(self->ps.Pi);
+  items[5] = dump_array(self->ps.Pp);
+  items[6] = dump_vec(scs_py_work_b(self->work), self->m);
+  items[7] = dump_vec(scs_py_work_c(self->work), self->n);
+  items[8] = dump_vec(self->sol->x, self->n);
+  items[9] = dump_vec(self->sol->y, self->m);
+  items[10] = dump_vec(self->sol->s, self->m);
+  PyThread_release_lock(self->lock);
+
+  for (i = 0; i < 11; ++i) {
+    if (!items[i]) {
+      goto done;
+    }
+  }
+  ret = Py_BuildValue("(nn)OOOOOOOOOOO", (Py_ssize_t)self->m,
+                      (Py_ssize_t)self->n, items[0], items[1], items[2],
+                      items[3], items[4], items[5], items[6], items[7],
+                      items[8], items[9], items[10]);
+done:
+  for (i = 0; i < 11; ++i) {
+    Py_XDECREF(items[i]);
+  }
+  return ret;
+}
+
+/* Replace the warm-start kept in sol by the given x, y, s (any of which
+ * may be None to keep the current value), without solving. */
+static PyObject *SCS_set_warm_start(SCS *self, PyObject *args) {
+  PyArrayObject *x, *y, *s;
+  int lock_ok, ok;
+
+  if (!PyArg_ParseTuple(args, "OOO", &x, &y, &s)) {
+    return (PyObject *)NULL;
+  }
+  lock_ok = lock_instance(self);
+  if (!lock_ok) {
+    return none_with_error("Failed to acquire instance lock");
+  }
+  if (!self->work) {
+    PyThread_release_lock(self->lock);
+    return none_with_error("Workspace not initialized!");
+  }
+  ok = (Py_IsNone((PyObject *)x) ||
+        get_warm_start(self->sol->x, self->n, x) == 0) &&
+       (Py_IsNone((PyObject *)y) ||
+        get_warm_start(self->sol->y, self->m, y) == 0) &&
+       (Py_IsNone((PyObject *)s) ||
+        get_warm_start(self->sol->s, self->m, s) == 0);
+  PyThread_release_lock(self->lock);
+  if (!ok) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
 static PyMethodDef scs_obj_methods[] = {
     {"solve", (PyCFunction)SCS_solve, METH_VARARGS, PyDoc_STR("Solve problem")},
     {"update", (PyCFunction)SCS_update, METH_VARARGS,
      PyDoc_STR("Update b or c vectors")},
+    {"_update_entries", (PyCFunction)SCS_update_entries, METH_VARARGS,
+     PyDoc_STR("Update some entries of b and/or c")},
+    {"update_matrices", (PyCFunction)SCS_update_matrices, METH_VARARGS,
+     PyDoc_STR("Rebuild the workspace with new nonzero values of A and/or P")},
+    {"solve_batch", (PyCFunction)SCS_solve_batch, METH_VARARGS,
+     PyDoc_STR("Solve for each row of stacked b and/or c batches")},
+    {"_problem_dump", (PyCFunction)SCS_problem_dump, METH_NOARGS,
+     PyDoc_STR("Copies of the retained problem data and warm-start")},
+    {"_set_warm_start", (PyCFunction)SCS_set_warm_start, METH_VARARGS,
+     PyDoc_STR("Replace the warm-start without solving")},
+    {"_set_callback", (PyCFunction)SCS_set_callback, METH_VARARGS,
+     PyDoc_STR("Set the progress callback and its interval")},
+    {"_set_trace", (PyCFunction)SCS_set_trace, METH_VARARGS,
+     PyDoc_STR("Set the convergence trace stride and length cap")},
     {NULL, NULL} /* sentinel */
 };
 
+static PyObject *SCS_get_converted_inputs(SCS *self, void *closure) {
+  if (!self->converted_inputs) {
+    return PyTuple_New(0);
+  }
+  return PyList_AsTuple(self->converted_inputs);
+}
+
+static PyGetSetDef scs_obj_getset[] = {
+    {"converted_inputs", (getter)SCS_get_converted_inputs, NULL,
+     PyDoc_STR("Names of the inputs that had to be copied (cast to the SCS "
+               "int/float type or made contiguous) during setup"),
+     NULL},
+    {NULL} /* sentinel */
+};
+
 /* Define workspace type object */
 static PyTypeObject SCS_Type = {
     PyVarObject_HEAD_INIT(NULL, 0) "scs.SCS", /* tp_name */
@@ -1295,7 +2985,7 @@ static PyTypeObject SCS_Type = {
     0,                                        /* tp_iternext */
     scs_obj_methods,                          /* tp_methods */
     0,                                        /* tp_members */
-    0,                                        /* tp_getset */
+    scs_obj_getset,                           /* tp_getset */
     0,                                        /* tp_base */
     0,                                        /* tp_dict */
     0,                                        /* tp_descr_get */
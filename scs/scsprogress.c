@@ -0,0 +1,269 @@
+/* Python progress callbacks and convergence traces for the SCS iteration
+ * loop.
+ *
+ * With CTRLC enabled the core polls scs_is_interrupted() once per
+ * iteration, with no lock or GIL held. This file builds the core's ctrlc.c
+ * under other names and provides the scs_* entry points itself: the
+ * interrupt check first defers to the SIGINT listener as before, then, for
+ * a solve that registered an ScsPyProgress for this thread, copies the
+ * latest residuals into the trace ring every `trace_stride` polls (no GIL
+ * needed) and, every `interval` polls, takes the GIL and calls the Python
+ * callback with them. A true return value, or the stop byte of a
+ * cancelled SCS.solve_async future, ends the solve after the current
+ * iteration: the poll lowers the workspace's max_iters to 0 so that the
+ * iteration loop exits the way it does on reaching max_iters, and
+ * scs_py_progress_finish restores it. Unlike Ctrl-C, which goes through
+ * the core's failure path, this keeps the last iterate in the solution
+ * (and so as the next warm start), reports finite residuals and prints
+ * nothing. CG backends
+ * also tally the linear system's CG iterations per ADMM iteration here.
+ * Other solves with neither a callback nor a trace pay one thread-local
+ * lookup per iteration. */
+
+#include "Python.h"
+#include "glbopts.h"
+#include "scs.h"
+#include "scs_types.h"
+#include "scs_work.h"
+#include "pythoncapi-compat/pythoncapi_compat.h"
+#include "scsprogress.h"
+#ifdef SCS_PY_CG_STATS
+#include "private.h" /* ScsLinSysWork, for its tot_cg_its */
+#endif
+
+#define scs_start_interrupt_listener scs_core_start_interrupt_listener
+#define scs_end_interrupt_listener scs_core_end_interrupt_listener
+#define scs_is_interrupted scs_core_is_interrupted
+#include "../scs_source/src/ctrlc.c"
+#undef scs_start_interrupt_listener
+#undef scs_end_interrupt_listener
+#undef scs_is_interrupted
+
+void scs_start_interrupt_listener(void);
+void scs_end_interrupt_listener(void);
+int scs_is_interrupted(void);
+
+/* Besides ctrlc.c, which must keep defining exactly the three functions
+ * renamed above, this file reads core internals that are not part of the
+ * public SCS API:
+ *   ScsWork (scs_work.h): r_orig (ScsResiduals *), scale (scs_float),
+ *     stgs (ScsSettings *, the workspace's own copy), b_orig and c_orig
+ *     (scs_float *, the unnormalized b and c) and, with SCS_PY_CG_STATS,
+ *     p (ScsLinSysWork *);
+ *   ScsResiduals (scs_work.h): last_iter (scs_int), res_pri, res_dual,
+ *     gap, pobj, dobj (scs_float);
+ *   ScsLinSysWork (the CG backends' private.h): tot_cg_its (scs_int).
+ * The checks below stop the build when a scs_source update renames one of
+ * them or changes its type; fill_row, have_residuals, count_cg,
+ * request_stop and scs_py_work_b/c must then be adapted. request_stop also relies on the loop
+ * in scs_solve re-reading stgs->max_iters as its bound on each pass. Pre-C11 compilers only get the size checked. */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SCS_PY_CORE_FIELD(T, f, FT)                                            \
+  _Static_assert(_Generic(((T *)0)->f, FT: 1, default: 0),                     \
+                 #T "::" #f " is no longer " #FT)
+#else
+#define SCS_PY_CORE_FIELD(T, f, FT)                                            \
+  typedef char scs_py_core_field_##T##_##f                                     \
+      [sizeof(((T *)0)->f) == sizeof(FT) ? 1 : -1]
+#endif
+SCS_PY_CORE_FIELD(ScsWork, r_orig, ScsResiduals *);
+SCS_PY_CORE_FIELD(ScsWork, scale, scs_float);
+SCS_PY_CORE_FIELD(ScsWork, stgs, ScsSettings *);
+SCS_PY_CORE_FIELD(ScsWork, b_orig, scs_float *);
+SCS_PY_CORE_FIELD(ScsWork, c_orig, scs_float *);
+SCS_PY_CORE_FIELD(ScsResiduals, last_iter, scs_int);
+SCS_PY_CORE_FIELD(ScsResiduals, res_pri, scs_float);
+SCS_PY_CORE_FIELD(ScsResiduals, res_dual, scs_float);
+SCS_PY_CORE_FIELD(ScsResiduals, gap, scs_float);
+SCS_PY_CORE_FIELD(ScsResiduals, pobj, scs_float);
+SCS_PY_CORE_FIELD(ScsResiduals, dobj, scs_float);
+#ifdef SCS_PY_CG_STATS
+SCS_PY_CORE_FIELD(ScsWork, p, ScsLinSysWork *);
+SCS_PY_CORE_FIELD(ScsLinSysWork, tot_cg_its, scs_int);
+#endif
+
+static Py_tss_t progress_key = Py_tss_NEEDS_INIT;
+
+int scs_py_progress_init(void) {
+  if (!PyThread_tss_is_created(&progress_key) &&
+      PyThread_tss_create(&progress_key) != 0) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "Failed to create thread-local progress slot");
+    return -1;
+  }
+  return 0;
+}
+
+ScsPyProgress *scs_py_progress_set(ScsPyProgress *p) {
+  ScsPyProgress *prev = (ScsPyProgress *)PyThread_tss_get(&progress_key);
+  PyThread_tss_set(&progress_key, p);
+  return prev;
+}
+
+const scs_float *scs_py_work_b(const ScsWork *w) {
+  return w->b_orig;
+}
+
+const scs_float *scs_py_work_c(const ScsWork *w) {
+  return w->c_orig;
+}
+
+int scs_py_progress_running(const void *owner) {
+  const ScsPyProgress *p = (ScsPyProgress *)PyThread_tss_get(&progress_key);
+  for (; p; p = p->prev) {
+    if (p->owner == owner) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void fill_row(ScsPyTraceRow *row, const ScsWork *w) {
+  const ScsResiduals *r = w->r_orig;
+  row->iter = r->last_iter;
+  row->res_pri = r->res_pri;
+  row->res_dual = r->res_dual;
+  row->gap = r->gap;
+  row->pobj = r->pobj;
+  row->dobj = r->dobj;
+  row->scale = w->scale;
+}
+
+/* Residuals are computed after the poll, so none exist on the first. */
+static int have_residuals(const ScsPyProgress *p) {
+  return p->work->r_orig && p->work->r_orig->last_iter >= 0;
+}
+
+static void record_trace(ScsPyProgress *p) {
+  fill_row(&p->trace[p->trace_count % p->trace_cap], p->work);
+  ++p->trace_count;
+}
+
+/* Add the CG iterations the linear system ran since the previous poll
+ * (one ADMM iteration, including any refactorization after a scale
+ * update) to p's counts. The core only keeps a running total over the
+ * workspace's lifetime, so the first poll of a solve just takes a mark. */
+static void count_cg(ScsPyProgress *p, int first) {
+#ifdef SCS_PY_CG_STATS
+  scs_int tot = p->work->p->tot_cg_its;
+  if (!first) {
+    scs_int its = tot - p->cg_mark;
+    int bin = 0;
+    p->cg_its += its;
+    if (its > p->cg_max) {
+      p->cg_max = its;
+    }
+    while (its > 0 && bin < SCS_PY_CG_HIST_BINS - 1) {
+      its >>= 1;
+      ++bin;
+    }
+    ++p->cg_hist[bin];
+  }
+  p->cg_mark = tot;
+#else
+  (void)p;
+  (void)first;
+#endif
+}
+
+/* End p's solve once the current iteration completes (see the top of this
+ * file). */
+static void request_stop(ScsPyProgress *p) {
+  p->stopped = 1;
+  if (!p->holding) {
+    p->max_iters = p->work->stgs->max_iters;
+    p->work->stgs->max_iters = 0;
+    p->holding = 1;
+  }
+}
+
+void scs_py_progress_finish(ScsPyProgress *p) {
+  const ScsPyTraceRow *last;
+  if (p->holding) {
+    p->work->stgs->max_iters = p->max_iters;
+    p->holding = 0;
+  }
+  if (p->polls) {
+    count_cg(p, 0);
+  }
+  if (!p->trace || !have_residuals(p)) {
+    return;
+  }
+  last = p->trace_count
+             ? &p->trace[(p->trace_count - 1) % p->trace_cap]
+             : NULL;
+  if (!last || last->iter != p->work->r_orig->last_iter) {
+    record_trace(p);
+  }
+}
+
+/* Call p->callback with the residuals of the last completed iteration,
+ * and stop the solve if it returns a true value or raises. */
+static void call_progress(ScsPyProgress *p) {
+  ScsPyTraceRow row;
+  PyGILState_STATE gil;
+  PyObject *stats, *ret;
+  int stop = 0;
+
+  fill_row(&row, p->work);
+  gil = PyGILState_Ensure();
+  stats = Py_BuildValue(
+      "{s:L,s:d,s:d,s:d,s:d,s:d,s:d}", "iter", (long long)row.iter,
+      "res_pri", (double)row.res_pri, "res_dual", (double)row.res_dual, "gap",
+      (double)row.gap, "pobj", (double)row.pobj, "dobj", (double)row.dobj,
+      "scale", (double)row.scale);
+  ret = stats ? PyObject_CallOneArg(p->callback, stats) : NULL;
+  Py_XDECREF(stats);
+  if (ret) {
+    stop = PyObject_IsTrue(ret);
+    Py_DECREF(ret);
+  }
+  if (!ret || stop < 0) {
+    /* Keep the exception for the binding to re-raise once scs_solve
+     * returns, and stop: the caller can't see the result anyway. */
+    p->exc = PyErr_GetRaisedException();
+    stop = 1;
+  }
+  PyGILState_Release(gil);
+  if (stop) {
+    request_stop(p);
+  }
+}
+
+void scs_start_interrupt_listener(void) {
+  scs_core_start_interrupt_listener();
+}
+
+void scs_end_interrupt_listener(void) {
+  scs_core_end_interrupt_listener();
+}
+
+int scs_is_interrupted(void) {
+  ScsPyProgress *p;
+  if (scs_core_is_interrupted()) {
+    return 1;
+  }
+  p = (ScsPyProgress *)PyThread_tss_get(&progress_key);
+  if (!p) {
+    return 0;
+  }
+  if (p->stopped) {
+    return 0;
+  }
+  if (p->stop && *p->stop) {
+    request_stop(p);
+    return 0;
+  }
+  ++p->polls;
+  count_cg(p, p->polls == 1);
+  if ((!p->callback && !p->trace) || !have_residuals(p)) {
+    return 0;
+  }
+  if (p->trace && p->polls % p->trace_stride == 0) {
+    record_trace(p);
+  }
+  if (p->callback && p->polls % p->interval == 0) {
+    call_progress(p);
+  }
+  return 0;
+}
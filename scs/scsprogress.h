@@ -0,0 +1,75 @@
+#ifndef PY_SCSPROGRESS_H
+#define PY_SCSPROGRESS_H
+
+/* Backends that solve the linear system with CG report per-solve CG
+ * iteration counts (info["lin_sys_iters"]). */
+#if defined PY_INDIRECT || defined PY_GPU
+#define SCS_PY_CG_STATS 1
+#endif
+
+/* Bins of the CG iteration histogram: bin 0 counts ADMM iterations with no
+ * CG iterations, bin k > 0 those with [2^(k-1), 2^k). */
+#define SCS_PY_CG_HIST_BINS 32
+
+/* One sample of the convergence trace (the trace_stride setting): the
+ * residuals of iteration `iter`, as also passed to the callback. */
+typedef struct {
+  scs_int iter;
+  scs_float res_pri;
+  scs_float res_dual;
+  scs_float gap;
+  scs_float pobj;
+  scs_float dobj;
+  scs_float scale;
+} ScsPyTraceRow;
+
+/* Per-solve state of the Python progress callback (the `callback` setting).
+ * The binding fills one in on the stack for each scs_solve call and
+ * registers it for the calling thread; the core's once-per-iteration
+ * interrupt check (see scsprogress.c) then samples it. */
+typedef struct ScsPyProgress {
+  PyObject *callback;   /* callable (strong ref) or NULL for no callback */
+  scs_int interval;     /* call back every `interval` iterations */
+  scs_int polls;        /* interrupt checks seen so far in this solve */
+  ScsWork *work;        /* workspace being solved, for its residuals */
+  const void *owner;    /* the SCS instance solving, see progress_running */
+  int stopped;          /* the callback or the stop byte ended the solve */
+  int holding;          /* work's max_iters is held at 0 until finish */
+  scs_int max_iters;    /* work's max_iters to restore */
+  const volatile char *stop; /* a nonzero byte here cancels, or NULL */
+  PyObject *exc;        /* exception raised by the callback, or NULL */
+  ScsPyTraceRow *trace; /* ring of trace_cap samples, or NULL */
+  scs_int trace_cap;
+  scs_int trace_stride; /* sample every `trace_stride` iterations */
+  scs_int trace_count;  /* samples taken; the ring keeps the last trace_cap */
+  scs_int cg_its;       /* CG iterations in this solve (SCS_PY_CG_STATS) */
+  scs_int cg_max;       /* most CG iterations in a single ADMM iteration */
+  scs_int cg_mark;      /* the linsys's running CG count at the last poll */
+  scs_int cg_hist[SCS_PY_CG_HIST_BINS]; /* ADMM iterations by CG count */
+  struct ScsPyProgress *prev; /* registration this one shadows */
+} ScsPyProgress;
+
+/* Record the state the solve ended in as the last trace sample (unless it
+ * already is), count the last iteration's CG work and undo what a stop did
+ * to the workspace. Call after every scs_solve; does not need the GIL. */
+void scs_py_progress_finish(ScsPyProgress *p);
+
+/* Create the thread-local slot; call once at module init (GIL held). */
+int scs_py_progress_init(void);
+
+/* Register p for solves run by the calling thread (NULL to clear) and
+ * return the previous registration. Does not need the GIL. */
+ScsPyProgress *scs_py_progress_set(ScsPyProgress *p);
+
+/* The current b and c of workspace w, unnormalized: what scs_init or the
+ * last scs_update received. Read-only; valid until the next scs_update or
+ * scs_finish on w. Declared here because this is the file that reads core
+ * internals. */
+const scs_float *scs_py_work_b(const ScsWork *w);
+const scs_float *scs_py_work_c(const ScsWork *w);
+
+/* Whether the calling thread is inside a solve registered with `owner`,
+ * e.g. running its callback. Does not need the GIL. */
+int scs_py_progress_running(const void *owner);
+
+#endif
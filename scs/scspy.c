@@ -13,10 +13,14 @@
  */
 
 #include "Python.h"            /* Python API */
+#include <stddef.h>            /* offsetof */
 #include "glbopts.h"           /* Constants and *alloc */
 #include "numpy/arrayobject.h" /* Numpy C API */
 #include "scs.h"               /* SCS API */
 #include "scs_types.h"         /* SCS primitive types */
+#ifdef _OPENMP
+#include <omp.h> /* omp_set_num_threads */
+#endif
 
 /* The PyInt variable is a PyLong in Python3.x. */
 #if PY_MAJOR_VERSION >= 3
@@ -25,6 +29,9 @@
 #endif
 
 static PyTypeObject SCS_Type; /* Declare SCS object type */
+static PyTypeObject ScsPySettings_Type; /* scs.Settings */
+static PyTypeObject ScsPyConeSpec_Type;  /* scs.ConeSpec */
 
+#include "scsprogress.h" /* Progress callbacks from the iteration loop */
 #include "scsmodule.h" /* SCS module definition */
 #include "scsobject.h" /* SCS object definition */
@@ -1,5 +1,10 @@
 from __future__ import print_function
+import asyncio
+import os
 import platform
+import subprocess
+import sys
+import threading
 
 
 def import_error(msg):
@@ -88,6 +93,92 @@ def test_update(solver_opts):
     assert_almost_equal(sol["x"][0], -1.0, decimal=2)
 
 
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_update_entries_matches_dense_update(solver_opts):
+    d, k = _slow_lp()
+    m, n = d["A"].shape
+    b_new, c_new = d["b"].copy(), d["c"].copy()
+    b_new[[3, 7]] = [0.5, 2.0]
+    c_new[n - 1] = 1.0
+
+    dense = scs.SCS(d, k, verbose=False, **solver_opts)
+    dense.update(b=b_new, c=c_new)
+    ref = dense.solve(warm_start=False)
+
+    sparse = scs.SCS(d, k, verbose=False, **solver_opts)
+    sparse.update(b_idx=[3, 7], b_val=[0.5, 2.0])
+    sparse.update(c_idx=n - 1, c_val=1.0)
+    sol = sparse.solve(warm_start=False)
+    assert sol["info"]["status"] == ref["info"]["status"]
+    assert_almost_equal(sol["x"], ref["x"], decimal=4)
+    assert_almost_equal(sol["y"], ref["y"], decimal=4)
+
+
+def test_update_entries_ignores_later_changes_to_inputs():
+    d, k = _slow_lp()
+    b_in, c_in = d["b"].copy(), d["c"].copy()
+    b_ref = b_in.copy()
+    b_ref[3] = 0.5
+    ref = scs.SCS(dict(d, b=b_ref), k, verbose=False).solve(warm_start=False)
+
+    solver = scs.SCS(dict(d, b=b_in, c=c_in), k, verbose=False)
+    # Changing the caller's arrays after setup must not reach the solver.
+    b_in[:] = 100.0
+    c_in[:] = 100.0
+    solver.update(b_idx=[3], b_val=0.5)
+    sol = solver.solve(warm_start=False)
+    assert sol["info"]["status"] == ref["info"]["status"]
+    assert_almost_equal(sol["x"], ref["x"], decimal=4)
+    assert_almost_equal(sol["y"], ref["y"], decimal=4)
+
+
+def test_update_entries_validates():
+    solver = scs.SCS(data, cone, verbose=False)
+    with pytest.raises(IndexError):
+        solver.update(b_idx=[2], b_val=1.0)
+    with pytest.raises(IndexError):
+        solver.update(c_idx=[-1], c_val=1.0)
+    with pytest.raises(TypeError):
+        solver.update(b_idx=[0.5], b_val=1.0)
+    with pytest.raises(ValueError):
+        solver.update(b_idx=[0, 1], b_val=[1.0, 2.0, 3.0])
+    with pytest.raises(ValueError):
+        solver.update(b=b, b_idx=[0], b_val=1.0)
+    with pytest.raises(ValueError):
+        solver.update(b_val=1.0)
+    # A rejected update leaves the problem unchanged.
+    sol = solver.solve()
+    assert_almost_equal(sol["x"][0], 1.0, decimal=2)
+
+
+def test_mixed_update_is_all_or_nothing():
+    solver = scs.SCS(data, cone, verbose=False, keep_problem=True)
+    with pytest.raises(IndexError):
+        solver.update(b=np.array([5.0, 5.0]), c_idx=[3], c_val=1.0)
+    with pytest.raises(ValueError):
+        solver.update(b_idx=[0], b_val=5.0, c=np.ones(2))
+    snap = solver._solver._problem_dump()
+    np.testing.assert_array_equal(snap[7], b)
+    np.testing.assert_array_equal(snap[8], c)
+    solver.update(b=np.array([5.0, 5.0]), c_idx=[0], c_val=2.0)
+    snap = solver._solver._problem_dump()
+    np.testing.assert_array_equal(snap[7], [5.0, 5.0])
+    np.testing.assert_array_equal(snap[8], [2.0])
+
+
+def test_partial_update_starts_from_current_vector():
+    solver = scs.SCS(data, cone, verbose=False, keep_problem=True)
+    solver.update(b_idx=[1], b_val=1.0)  # scratch copy made here
+    solver.update(b=np.array([2.0, 2.0]))  # and dropped here
+    solver.update(b_idx=[0], b_val=3.0)
+    np.testing.assert_array_equal(solver._solver._problem_dump()[7],
+                                  [3.0, 2.0])
+    solver.solve_batch(b=np.array([[4.0, 4.0], [5.0, 5.0]]))
+    solver.update(b_idx=[1], b_val=6.0)
+    np.testing.assert_array_equal(solver._solver._problem_dump()[7],
+                                  [5.0, 6.0])
+
+
 @pytest.mark.parametrize("solver_opts", _solver_configs)
 def test_warm_start(solver_opts):
     # max x
@@ -131,3 +222,922 @@ def test_init_type_error_is_informative(bad_kwarg, expected_in_msg):
         f"expected {expected_in_msg!r} in error message, got: {msg!r}"
     )
     assert "Error parsing inputs" not in msg
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_solve_batch_matches_sequential_solves(solver_opts):
+    # rows: max x s.t. 0 <= x <= 1, min x s.t. 0 <= x <= 1,
+    # max x s.t. -1 <= x <= 1
+    b_batch = np.array([[1.0, 0.0], [1.0, 0.0], [1.0, 1.0]])
+    c_batch = np.array([[-1.0], [1.0], [-1.0]])
+    batch = scs.SCS(data, cone, verbose=False, **solver_opts)
+    sol = batch.solve_batch(b=b_batch, c=c_batch)
+    assert sol["x"].shape == (3, 1)
+    assert sol["y"].shape == (3, 2)
+    assert sol["s"].shape == (3, 2)
+    assert sol["info"].shape == (3,)
+    assert_almost_equal(sol["x"][:, 0], [1.0, 0.0, 1.0], decimal=2)
+    assert list(sol["info"]["status_val"]) == [scs.SOLVED] * 3
+
+    single = scs.SCS(data, cone, verbose=False, **solver_opts)
+    for i in range(3):
+        single.update(b=b_batch[i], c=c_batch[i])
+        ref = single.solve()
+        assert_almost_equal(sol["x"][i], ref["x"], decimal=2)
+        assert_almost_equal(sol["info"]["pobj"][i], ref["info"]["pobj"],
+                            decimal=2)
+
+
+def test_solve_batch_keeps_unbatched_vector():
+    solver = scs.SCS(data, cone, verbose=False)
+    sol = solver.solve_batch(c=np.array([[-1.0], [1.0]]))
+    assert_almost_equal(sol["x"][:, 0], [1.0, 0.0], decimal=2)
+    # The workspace keeps the last row, as after update(c=...).
+    assert_almost_equal(solver.solve()["x"][0], 0.0, decimal=2)
+
+
+def test_solve_batch_validates_inputs():
+    solver = scs.SCS(data, cone, verbose=False)
+    with pytest.raises(ValueError):
+        solver.solve_batch()
+    with pytest.raises(ValueError):
+        solver.solve_batch(b=np.ones((2, 3)))
+    with pytest.raises(ValueError):
+        solver.solve_batch(b=np.ones((2, 2)), c=np.ones((3, 1)))
+    with pytest.raises(TypeError):
+        solver.solve_batch(b=np.ones(2))
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_solve_into_out_buffers(solver_opts):
+    solver = scs.SCS(data, cone, verbose=False, **solver_opts)
+    out_x, out_y, out_s = np.empty(1), np.empty(2), np.empty(2)
+    sol = solver.solve(out_x=out_x, out_y=out_y, out_s=out_s)
+    assert sol["x"] is out_x
+    assert sol["y"] is out_y
+    assert sol["s"] is out_s
+    assert_almost_equal(out_x[0], 1.0, decimal=2)
+
+    # Buffers are reused across solves; the warm-start is unaffected.
+    solver.update(c=np.array([1.0]))
+    solver.solve(out_x=out_x)
+    assert_almost_equal(out_x[0], 0.0, decimal=2)
+
+
+def test_solve_out_buffers_are_validated():
+    solver = scs.SCS(data, cone, verbose=False)
+    with pytest.raises(ValueError):
+        solver.solve(out_x=np.empty(2))
+    with pytest.raises(TypeError):
+        solver.solve(out_x=np.empty(1, dtype=np.float32))
+    with pytest.raises(TypeError):
+        solver.solve(out_x=[0.0])
+    with pytest.raises(ValueError):
+        solver.solve(out_y=np.empty(4)[::2])
+    readonly = np.empty(2)
+    readonly.flags.writeable = False
+    with pytest.raises(ValueError):
+        solver.solve(out_s=readonly)
+    with pytest.raises(TypeError):
+        solver.solve(out_x=np.empty(1, dtype=np.dtype(np.float64).newbyteorder()))
+    ys = np.empty(3)
+    with pytest.raises(ValueError, match="share memory"):
+        solver.solve(out_y=ys[:2], out_s=ys[1:])
+    with pytest.raises(ValueError, match="share memory"):
+        solver.solve(out_y=ys[:2], out_s=ys[:2])
+
+
+def test_solve_lite_info():
+    solver = scs.SCS(data, cone, verbose=False)
+    info = solver.solve(lite_info=True)["info"]
+    assert set(info) == {
+        "status", "status_val", "iter", "pobj", "dobj", "res_pri",
+        "res_dual", "gap", "solve_time",
+    }
+    assert info["status_val"] == scs.SOLVED
+
+
+def test_converted_inputs_reports_copies():
+    int_dtype = np.int64 if scs.__sizeof_int__ == 8 else np.int32
+    A_native = A.copy()
+    A_native.indices = A_native.indices.astype(int_dtype)
+    A_native.indptr = A_native.indptr.astype(int_dtype)
+    solver = scs.SCS({"A": A_native, "b": b, "c": c}, cone, verbose=False)
+    assert solver.converted_inputs == ()
+
+    # float32 c and a strided b must be converted before SCS can use them.
+    b_strided = np.array([1.0, 7.0, 0.0])[::2]
+    solver = scs.SCS(
+        {"A": A_native, "b": b_strided, "c": c.astype(np.float32)},
+        cone,
+        verbose=False,
+    )
+    assert set(solver.converted_inputs) == {"b", "c"}
+    assert_almost_equal(solver.solve()["x"][0], 1.0, decimal=2)
+
+
+def test_upper_triangular_P_is_passed_through():
+    P_upper = sp.csc_matrix(np.array([[2.0, 1.0], [0.0, 3.0]]))
+    qp = {"A": sp.csc_matrix(np.eye(2)), "P": P_upper, "b": np.ones(2),
+          "c": np.ones(2)}
+    _, _, _, _, Px, Pi, Pp, _, _ = scs._prepare_data(qp, {"l": 2})
+    assert Px is P_upper.data and Pi is P_upper.indices
+    assert Pp is P_upper.indptr
+    # A full symmetric P still has its lower triangle dropped.
+    qp["P"] = P_upper + P_upper.T
+    _, _, _, _, Px, Pi, Pp, _, _ = scs._prepare_data(qp, {"l": 2})
+    np.testing.assert_array_equal(Px, [4.0, 1.0, 6.0])
+    np.testing.assert_array_equal(Pi, [0, 0, 1])
+    np.testing.assert_array_equal(Pp, [0, 1, 3])
+
+
+def test_borrowed_inputs_are_not_modified():
+    b_in, c_in = b.copy(), c.copy()
+    solver = scs.SCS({"A": A, "b": b_in, "c": c_in}, cone, verbose=False)
+    assert "b" not in solver.converted_inputs
+    solver.solve()
+    assert_almost_equal(b_in, b)
+    assert_almost_equal(c_in, c)
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_update_matrices_matches_fresh_solver(solver_opts):
+    # max x s.t. 0 <= 2 x <= 1  ->  x = 0.5
+    solver = scs.SCS(data, cone, verbose=False, keep_problem=True, **solver_opts)
+    solver.solve()
+    solver.update_matrices(Ax=np.array([2.0, -2.0]))
+    sol = solver.solve()
+    assert_almost_equal(sol["x"][0], 0.5, decimal=2)
+
+    A_new = sp.csc_matrix([2.0, -2.0]).T.tocsc()
+    ref = scs.SCS({"A": A_new, "b": b, "c": c}, cone, verbose=False,
+                  **solver_opts).solve()
+    assert_almost_equal(sol["x"], ref["x"], decimal=3)
+
+
+def test_update_matrices_keeps_updated_b_and_c():
+    solver = scs.SCS(data, cone, verbose=False, keep_problem=True)
+    solver.update(b=np.array([1.0, 1.0]), c=np.array([1.0]))
+    solver.update_matrices(Ax=np.array([2.0, -2.0]))
+    # min x s.t. -1 <= 2 x <= 1  ->  x = -0.5
+    assert_almost_equal(solver.solve()["x"][0], -0.5, decimal=2)
+
+
+def test_update_matrices_P():
+    P = sp.csc_matrix(np.array([[1.0]]))
+    # min 0.5 p x^2 - x s.t. 0 <= x <= 1  ->  x = min(1 / p, 1)
+    solver = scs.SCS({"A": A, "P": P, "b": b, "c": c}, cone, verbose=False, keep_problem=True)
+    assert_almost_equal(solver.solve()["x"][0], 1.0, decimal=2)
+    solver.update_matrices(Px=np.array([4.0]))
+    assert_almost_equal(solver.solve()["x"][0], 0.25, decimal=2)
+
+
+def test_kept_matrices_are_copies():
+    # Index arrays already in the SCS dtype are used by setup as they are,
+    # so only the keep_problem copy protects them.
+    int_dtype = np.int64 if scs.__sizeof_int__ == 8 else np.int32
+    A_in = A.copy()
+    A_in.indices = A_in.indices.astype(int_dtype)
+    A_in.indptr = A_in.indptr.astype(int_dtype)
+    solver = scs.SCS({"A": A_in, "b": b, "c": c}, cone, verbose=False,
+                     keep_problem=True)
+    A_in.data[:] = 5.0
+    A_in.indices[:] = 1
+    A_in.indptr[:] = 0
+    snap = solver._solver._problem_dump()
+    np.testing.assert_array_equal(snap[1], A.data)
+    np.testing.assert_array_equal(snap[2], A.indices)
+    np.testing.assert_array_equal(snap[3], A.indptr)
+    Ax = np.array([2.0, -2.0])
+    solver.update_matrices(Ax=Ax)
+    Ax[:] = 5.0
+    np.testing.assert_array_equal(solver._solver._problem_dump()[1],
+                                  [2.0, -2.0])
+
+
+def test_update_matrices_validates_inputs():
+    solver = scs.SCS(data, cone, verbose=False, keep_problem=True)
+    with pytest.raises(ValueError):
+        solver.update_matrices(Ax=np.ones(3))
+    with pytest.raises(TypeError):
+        solver.update_matrices(Ax=[1.0, -1.0])
+    with pytest.raises(ValueError, match="no P"):
+        solver.update_matrices(Px=np.ones(1))
+    # A failed update leaves the solver usable.
+    assert_almost_equal(solver.solve()["x"][0], 1.0, decimal=2)
+
+
+def test_problem_is_kept_only_with_keep_problem(tmp_path):
+    solver = scs.SCS(data, cone, verbose=False)
+    with pytest.raises(ValueError, match="keep_problem"):
+        solver.update_matrices(Ax=np.array([2.0, -2.0]))
+    with pytest.raises(ValueError, match="keep_problem"):
+        solver.save_problem(str(tmp_path / "problem.scs"))
+    # Partial updates work without it, on a copy of the caller's b.
+    b_in = b.copy()
+    solver.update(b=b_in)
+    solver.update(b_idx=[1], b_val=1.0)
+    assert_almost_equal(b_in, b)
+    solver.update(c=np.array([1.0]))
+    # min x s.t. -1 <= x <= 1  ->  x = -1
+    assert_almost_equal(solver.solve()["x"][0], -1.0, decimal=2)
+
+
+@pytest.fixture
+def index_cache():
+    scs.clear_index_cache()
+    scs.set_index_cache_limit(1 << 20)
+    yield
+    scs.set_index_cache_limit(0)
+    scs.clear_index_cache()
+
+
+def _qp_with_unsorted_pattern():
+    # A has unsorted row indices in column 0, P is given in full (both
+    # triangles), so both need canonicalizing.
+    A = sp.csc_matrix(
+        (np.array([-1.0, 1.0]), np.array([1, 0]), np.array([0, 2])),
+        shape=(2, 1),
+    )
+    assert not A.has_sorted_indices
+    P = sp.csc_matrix(np.array([[2.0]]))
+    return {"A": A, "P": P, "b": b, "c": c}
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_index_cache_matches_uncached(solver_opts, index_cache):
+    qp = _qp_with_unsorted_pattern()
+    scs.set_index_cache_limit(0)
+    ref = scs.SCS(qp, cone, verbose=False, **solver_opts).solve()
+    scs.set_index_cache_limit(1 << 20)
+    for _ in range(3):
+        sol = scs.SCS(qp, cone, verbose=False, **solver_opts).solve()
+        assert_almost_equal(sol["x"], ref["x"], decimal=6)
+        assert_almost_equal(sol["y"], ref["y"], decimal=6)
+    stats = scs.index_cache_stats()
+    assert stats["misses"] == 2  # A and P
+    assert stats["hits"] == 4
+    assert stats["entries"] == 2
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+def test_index_cache_reuses_pattern_with_new_values(index_cache):
+    qp = _qp_with_unsorted_pattern()
+    scs.SCS(qp, cone, verbose=False)
+    # Same pattern, different values: hits the cache and permutes the new
+    # values, not the cached ones.
+    qp2 = dict(qp, A=qp["A"] * 2.0, P=qp["P"] * 3.0)
+    args = scs._prepare_data(qp2, cone, np.dtype(np.int64))
+    _, Ax, Ai, Ap, Px, _, _, _, _ = args
+    assert scs.index_cache_stats()["hits"] == 2
+    np.testing.assert_array_equal(Ai, [0, 1])
+    np.testing.assert_array_equal(Ax, [2.0, -2.0])
+    np.testing.assert_array_equal(Px, [6.0])
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+def test_index_cache_extracts_upper_triangle(index_cache):
+    P = sp.csc_matrix(np.array([[2.0, 1.0], [1.0, 3.0]]))
+    A = sp.csc_matrix(np.eye(2))
+    qp = {"A": A, "P": P, "b": np.ones(2), "c": np.ones(2)}
+    ref = scs._prepare_data(qp, {"l": 2})
+    for _ in range(2):
+        args = scs._prepare_data(qp, {"l": 2}, np.dtype(np.int32))
+        for got, want in zip(args[1:], ref[1:]):
+            np.testing.assert_array_equal(got, want)
+    assert args[5].dtype == np.int32
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+def test_index_cache_keeps_duplicates_like_uncached(index_cache):
+    # Duplicate entries in both triangles: the lower ones are dropped, the
+    # upper ones kept as given, and the cached permutation and the
+    # uncached path must agree entry for entry.
+    P = sp.csc_matrix(
+        (np.array([2.0, 1.0, 0.5, 1.0, 3.0, 0.25]),
+         np.array([0, 1, 1, 0, 1, 0]), np.array([0, 3, 6])), shape=(2, 2))
+    qp = {"A": sp.csc_matrix(np.eye(2)), "P": P, "b": np.ones(2),
+          "c": np.ones(2)}
+    scs.set_index_cache_limit(0)
+    want = scs._prepare_data(qp, {"l": 2}, np.dtype(np.int64))
+    scs.set_index_cache_limit(1 << 20)
+    for _ in range(2):
+        got = scs._prepare_data(qp, {"l": 2}, np.dtype(np.int64))
+        for g, w in zip(got[4:7], want[4:7]):
+            np.testing.assert_array_equal(g, w)
+    np.testing.assert_array_equal(want[4], [2.0, 1.0, 0.25, 3.0])
+    np.testing.assert_array_equal(want[5], [0, 0, 0, 1])
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+def test_index_cache_bypassed_for_canonical_input(index_cache):
+    int_dtype = np.dtype(np.int64)
+    A_native = sp.csc_matrix(np.eye(2))
+    A_native.indices = A_native.indices.astype(int_dtype)
+    A_native.indptr = A_native.indptr.astype(int_dtype)
+    args = scs._prepare_data(
+        {"A": A_native, "b": np.ones(2), "c": np.ones(2)}, {"l": 2},
+        int_dtype)
+    assert args[1] is A_native.data and args[2] is A_native.indices
+    stats = scs.index_cache_stats()
+    assert stats["hits"] == stats["misses"] == 0
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+def test_index_cache_evicts_and_disables(index_cache):
+    for k in range(1, 6):
+        A = sp.csc_matrix(np.ones((k, 1)))
+        scs._prepare_data(
+            {"A": A, "b": np.ones(k), "c": np.ones(1)}, {"l": k},
+            np.dtype(np.int64))
+    stats = scs.index_cache_stats()
+    assert stats["misses"] == 5 and stats["evictions"] == 0
+    scs.set_index_cache_limit(1)
+    stats = scs.index_cache_stats()
+    assert stats["entries"] == 0 and stats["bytes"] == 0
+    assert stats["evictions"] == 5
+    scs.set_index_cache_limit(0)
+    scs._prepare_data(data, cone, np.dtype(np.int64))
+    assert scs.index_cache_stats()["misses"] == 5
+    with pytest.raises(ValueError):
+        scs.set_index_cache_limit(-1)
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_save_load_problem_roundtrip(solver_opts, tmp_path):
+    solver = scs.SCS(data, cone, verbose=False, keep_problem=True, eps_abs=1e-6, **solver_opts)
+    solver.solve()
+    solver.update(b=np.array([1.0, 1.0]))
+    sol = solver.solve()
+    path = str(tmp_path / "problem.scs")
+    solver.save_problem(path)
+
+    loaded = scs.SCS.load_problem(path)
+    # Arrays come straight from the map in the SCS types, nothing to copy.
+    assert loaded.converted_inputs == ()
+    assert loaded._settings["eps_abs"] == 1e-6
+    # Saved solution is the warm-start: the loaded instance is already at
+    # the optimum of the updated problem.
+    sol2 = loaded.solve()
+    assert_almost_equal(sol2["x"], sol["x"], decimal=4)
+    assert_array_less(sol2["info"]["iter"], sol["info"]["iter"] + 1)
+    ref = scs.SCS(
+        dict(data, b=np.array([1.0, 1.0])), cone, verbose=False,
+        **solver_opts).solve(warm_start=False)
+    assert_almost_equal(sol2["x"], ref["x"], decimal=2)
+
+
+def test_save_load_problem_with_P_and_overrides(tmp_path):
+    qp = _qp_with_unsorted_pattern()
+    solver = scs.SCS(qp, cone, verbose=False, keep_problem=True)
+    solver.update_matrices(Px=np.array([4.0]))
+    solver.save_problem(str(tmp_path / "qp.scs"))
+    loaded = scs.SCS.load_problem(
+        str(tmp_path / "qp.scs"), max_iters=7, linear_solver="cpu_indirect")
+    assert loaded._settings["max_iters"] == 7
+    assert loaded._linear_solver == "cpu_indirect"
+    snap = solver._solver._problem_dump()
+    snap2 = loaded._solver._problem_dump()
+    assert snap[0] == snap2[0]
+    for a, b in zip(snap[1:9], snap2[1:9]):
+        np.testing.assert_array_equal(a, b)
+    np.testing.assert_array_equal(snap2[4], [4.0])
+
+
+def test_load_problem_rejects_bad_files(tmp_path):
+    bad = tmp_path / "bad.scs"
+    bad.write_bytes(b"not a problem file at all")
+    with pytest.raises(ValueError, match="not an SCS problem file"):
+        scs.SCS.load_problem(str(bad))
+    path = str(tmp_path / "ok.scs")
+    scs.SCS(data, cone, verbose=False, keep_problem=True).save_problem(path)
+    raw = bytearray(open(path, "rb").read())
+    raw[8] = 99  # version
+    bad.write_bytes(bytes(raw))
+    with pytest.raises(ValueError, match="version 99"):
+        scs.SCS.load_problem(str(bad))
+    raw[8] = 1
+    bad.write_bytes(bytes(raw[:-8]))
+    with pytest.raises(ValueError, match="truncated"):
+        scs.SCS.load_problem(str(bad))
+
+
+@pytest.mark.parametrize("use_mmap", [True, False])
+def test_from_file_matches_original(use_mmap, tmp_path):
+    path = str(tmp_path / "dump.bin")
+    qp = _qp_with_unsorted_pattern()
+    ref = scs.SCS(qp, cone, verbose=False, write_data_filename=path).solve()
+    solver = scs.SCS.from_file(path, mmap=use_mmap, verbose=False)
+    assert solver._cone["l"] == 2
+    sol = solver.solve()
+    assert_almost_equal(sol["x"], ref["x"], decimal=6)
+    assert_almost_equal(sol["y"], ref["y"], decimal=6)
+    # The loaded instance is a regular one.
+    solver.update(b=np.array([1.0, 1.0]))
+    solver.solve()
+
+
+def test_from_file_box_and_soc_cones(tmp_path):
+    path = str(tmp_path / "dump.bin")
+    A = sp.csc_matrix(np.vstack([np.eye(2), np.zeros((1, 2)), np.eye(2)]))
+    box = {"bu": [1.0, 2.0], "bl": [-1.0, -2.0], "q": [2]}
+    d = {"A": A, "b": np.array([1.0, 0.0, 0.0, 3.0, 0.0]),
+         "c": np.array([1.0, -1.0])}
+    ref = scs.SCS(d, box, verbose=False, write_data_filename=path).solve()
+    solver = scs.SCS.from_file(path, verbose=False)
+    assert solver._cone["bu"] == [1.0, 2.0]
+    assert solver._cone["bl"] == [-1.0, -2.0]
+    assert solver._cone["q"] == [2]
+    assert_almost_equal(solver.solve()["x"], ref["x"], decimal=6)
+
+
+def test_from_file_rejects_bad_files(tmp_path):
+    path = str(tmp_path / "dump.bin")
+    scs.SCS(data, cone, verbose=False, write_data_filename=path)
+    raw = open(path, "rb").read()
+    bad = tmp_path / "bad.bin"
+    bad.write_bytes(raw[: len(raw) // 2])
+    with pytest.raises(ValueError, match="truncated"):
+        scs.SCS.from_file(str(bad))
+    bad.write_bytes(b"\x03\x00\x00\x00" + raw[4:])
+    with pytest.raises(ValueError, match="not an SCS data file"):
+        scs.SCS.from_file(str(bad))
+
+
+def _slow_lp():
+    # A random feasible LP that takes SCS more than a handful of iterations.
+    rng = np.random.default_rng(0)
+    m, n = 40, 20
+    A = sp.random(m, n, density=0.3, random_state=1, format="csc")
+    A = sp.vstack([A, sp.eye(n)]).tocsc()
+    x0 = rng.random(n)
+    b = np.concatenate([A[:m] @ x0 + rng.random(m), np.zeros(n)]) + 0.1
+    b[m:] = 0
+    return {"A": A, "b": b, "c": -rng.random(n)}, {"l": m + n}
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_progress_callback_samples_iterations(solver_opts):
+    d, k = _slow_lp()
+    stats = []
+    solver = scs.SCS(d, k, verbose=False, callback=stats.append,
+                     callback_interval=2, eps_abs=1e-9, eps_rel=1e-9,
+                     max_iters=50, **solver_opts)
+    sol = solver.solve(warm_start=False)
+    assert stats
+    assert set(stats[0]) == {"iter", "res_pri", "res_dual", "gap", "pobj",
+                             "dobj", "scale"}
+    iters = [st["iter"] for st in stats]
+    assert iters == sorted(iters)
+    assert iters[-1] < sol["info"]["iter"]
+    assert len(stats) <= sol["info"]["iter"] // 2 + 1
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_progress_callback_stops_solve(solver_opts):
+    d, k = _slow_lp()
+    solver = scs.SCS(d, k, verbose=False, max_iters=10000, **solver_opts)
+    solver.set_callback(lambda st: st["iter"] >= 3)
+    sol = solver.solve(warm_start=False)
+    assert sol["info"]["status_val"] == scs.SIGINT
+    assert sol["info"]["status"] == "interrupted"
+    assert sol["info"]["iter"] < 10
+    # The stopped solve returns its last iterate, not the failure NaNs.
+    for key in ("x", "y", "s"):
+        assert np.all(np.isfinite(sol[key]))
+    assert np.isfinite(sol["info"]["res_pri"])
+    assert np.isfinite(sol["info"]["pobj"])
+
+    # Removing the callback restores normal solves, warm-started from the
+    # stopped iterate.
+    solver.set_callback(None)
+    sol = solver.solve()
+    assert sol["info"]["status_val"] == scs.SOLVED
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_progress_callback_stop_ends_batch(solver_opts):
+    d, k = _slow_lp()
+    solver = scs.SCS(d, k, verbose=False, max_iters=10000, **solver_opts)
+    solver.set_callback(lambda st: st["iter"] >= 3)
+    sol = solver.solve_batch(b=np.stack([d["b"]] * 3), warm_start=False)
+    info = sol["info"]
+    assert info["status_val"][0] == scs.SIGINT
+    assert np.all(np.isfinite(sol["x"][0]))
+    assert list(info["status_val"][1:]) == [scs.UNFINISHED] * 2
+    assert list(info["iter"][1:]) == [0, 0]
+    assert np.all(np.isnan(sol["x"][1:]))
+    assert np.all(np.isnan(sol["s"][1:]))
+
+    solver.set_callback(None)
+    assert solver.solve()["info"]["status_val"] == scs.SOLVED
+
+
+def test_progress_callback_exception_propagates():
+    d, k = _slow_lp()
+
+    def boom(stats):
+        raise RuntimeError("stop here")
+
+    solver = scs.SCS(d, k, verbose=False, callback=boom, max_iters=1000)
+    with pytest.raises(RuntimeError, match="stop here"):
+        solver.solve(warm_start=False)
+    with pytest.raises(RuntimeError, match="stop here"):
+        solver.solve_batch(b=np.stack([d["b"], d["b"]]), warm_start=False)
+    # The instance stays usable.
+    solver.set_callback(None)
+    solver.solve()
+
+
+def test_progress_callback_cannot_reenter_its_instance():
+    d, k = _slow_lp()
+    other = scs.SCS(data, cone, verbose=False)
+    inner = []
+
+    def reenter(stats):
+        inner.append(other.solve()["info"]["status_val"])
+        solver.update(b=d["b"])
+
+    solver = scs.SCS(d, k, verbose=False, callback=reenter, max_iters=1000)
+    with pytest.raises(RuntimeError, match="progress callback"):
+        solver.solve(warm_start=False)
+    assert inner == [scs.SOLVED]
+    solver.set_callback(lambda stats: solver.save_problem("unused"))
+    with pytest.raises(RuntimeError, match="progress callback"):
+        solver.solve(warm_start=False)
+    # The instance stays usable.
+    solver.set_callback(None)
+    solver.solve()
+
+
+def test_progress_callback_validates():
+    solver = scs.SCS(data, cone, verbose=False)
+    with pytest.raises(TypeError):
+        solver.set_callback(3)
+    with pytest.raises(ValueError):
+        solver.set_callback(print, interval=0)
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_trace_records_strided_iterations(solver_opts):
+    d, k = _slow_lp()
+    solver = scs.SCS(d, k, verbose=False, trace_stride=3, max_iters=40,
+                     eps_abs=1e-9, eps_rel=1e-9, **solver_opts)
+    info = solver.solve(warm_start=False)["info"]
+    trace = info["trace"]
+    assert trace.dtype.names == ("iter", "res_pri", "res_dual", "gap",
+                                 "pobj", "dobj", "scale")
+    iters = trace["iter"]
+    assert len(iters) >= 2
+    assert np.all(np.diff(iters[:-1]) == 3)
+    # The last record is the iterate the solve ended on.
+    assert info["iter"] - 1 <= iters[-1] <= info["iter"]
+    assert np.all(np.isfinite(trace["res_pri"]))
+    assert "trace" in solver.solve(lite_info=True)["info"]
+
+
+def test_trace_keeps_last_samples_up_to_cap():
+    d, k = _slow_lp()
+    solver = scs.SCS(d, k, verbose=False, trace_stride=1, trace_max_len=5,
+                     max_iters=40, eps_abs=1e-9, eps_rel=1e-9)
+    info = solver.solve(warm_start=False)["info"]
+    iters = info["trace"]["iter"]
+    assert len(iters) == 5
+    np.testing.assert_array_equal(np.diff(iters), 1)
+    assert info["iter"] - 1 <= iters[-1] <= info["iter"]
+
+
+def test_trace_disabled_by_default_and_validated():
+    assert "trace" not in scs.SCS(data, cone, verbose=False).solve()["info"]
+    with pytest.raises(ValueError):
+        scs.SCS(data, cone, trace_stride=-1)
+    with pytest.raises(ValueError):
+        scs.SCS(data, cone, trace_stride=1, trace_max_len=0)
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_num_threads_setting(solver_opts):
+    d, k = _slow_lp()
+    ref = scs.SCS(d, k, verbose=False, **solver_opts).solve()
+    has_openmp = scs._select_scs_module(dict(solver_opts)).has_openmp()
+    if has_openmp:
+        solver = scs.SCS(d, k, verbose=False, num_threads=2, **solver_opts)
+    else:
+        with pytest.warns(UserWarning, match="num_threads has no effect"):
+            solver = scs.SCS(d, k, verbose=False, num_threads=2,
+                             **solver_opts)
+    sol = solver.solve()
+    assert_almost_equal(sol["x"], ref["x"], decimal=4)
+    with pytest.raises(ValueError, match="num_threads"):
+        scs.SCS(d, k, verbose=False, num_threads=-1, **solver_opts)
+
+
+def test_lin_sys_iters_reported_for_cg_backends():
+    d, k = _slow_lp()
+    solver = scs.SCS(d, k, verbose=False, max_iters=40,
+                     linear_solver=scs.LinearSolver.CPU_INDIRECT)
+    info = solver.solve(warm_start=False)["info"]
+    cg = info["lin_sys_iters"]
+    assert set(cg) == {"total", "max", "mean", "hist"}
+    assert 0 < cg["max"] <= cg["total"]
+    assert 0 < cg["mean"] <= cg["max"]
+    # hist counts ADMM iterations by CG iterations: bin 0 holds those with
+    # none, bin k those with [2**(k-1), 2**k), up to the bin of the max.
+    hist = cg["hist"]
+    assert len(hist) == int(cg["max"]).bit_length() + 1
+    assert hist[-1] > 0
+    assert_almost_equal(cg["mean"] * hist.sum(), cg["total"])
+    assert "lin_sys_iters" not in solver.solve(lite_info=True)["info"]
+
+    direct = scs.SCS(d, k, verbose=False,
+                     linear_solver=scs.LinearSolver.QDLDL)
+    assert "lin_sys_iters" not in direct.solve()["info"]
+
+
+@pytest.mark.thread_unsafe(reason="uses the shared solve_async threads")
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_solve_async_matches_solve(solver_opts):
+    d, k = _slow_lp()
+    ref = scs.SCS(d, k, verbose=False, **solver_opts).solve()
+    solver = scs.SCS(d, k, verbose=False, **solver_opts)
+    futs = [solver.solve_async(warm_start=False) for _ in range(3)]
+    for fut in futs:
+        sol = fut.result(timeout=60)
+        assert sol["info"]["status"] == ref["info"]["status"]
+        assert_almost_equal(sol["x"], ref["x"], decimal=4)
+
+
+@pytest.mark.thread_unsafe(reason="uses the shared solve_async threads")
+def test_solve_async_cancel_stops_running_solve():
+    d, k = _slow_lp()
+    started, proceed = threading.Event(), threading.Event()
+
+    def hold(stats):
+        started.set()
+        proceed.wait(timeout=30)
+
+    solver = scs.SCS(d, k, verbose=False, callback=hold, max_iters=100000)
+    fut = solver.solve_async(warm_start=False)
+    assert started.wait(timeout=30)
+    assert not fut.cancel()  # already running: asked to stop instead
+    proceed.set()
+    sol = fut.result(timeout=30)
+    assert sol["info"]["status_val"] == scs.SIGINT
+    assert not fut.cancelled()
+    assert np.all(np.isfinite(sol["x"]))
+    assert np.isfinite(sol["info"]["res_pri"])
+
+    # The instance stays usable, warm-started from the cancelled iterate.
+    solver.set_callback(None)
+    sol = solver.solve_async().result(timeout=60)
+    assert sol["info"]["status_val"] == scs.SOLVED
+    assert solver.solve()["info"]["status_val"] == scs.SOLVED
+
+
+@pytest.mark.thread_unsafe(reason="uses the shared solve_async threads")
+def test_solve_async_queue_does_not_starve_other_instances():
+    if (os.cpu_count() or 1) < 2:
+        pytest.skip("needs at least two solve_async threads")
+    d, k = _slow_lp()
+    started, proceed = threading.Event(), threading.Event()
+
+    def hold(stats):
+        started.set()
+        proceed.wait(timeout=30)
+
+    busy = scs.SCS(d, k, verbose=False, callback=hold, max_iters=5)
+    # More jobs than pool threads, all on one instance.
+    futs = [busy.solve_async(warm_start=False)
+            for _ in range((os.cpu_count() or 1) + 1)]
+    try:
+        assert started.wait(timeout=30)
+        other = scs.SCS(data, cone, verbose=False)
+        sol = other.solve_async().result(timeout=30)
+        assert sol["info"]["status_val"] == scs.SOLVED
+    finally:
+        proceed.set()
+    for fut in futs:
+        fut.result(timeout=60)
+
+
+@pytest.mark.thread_unsafe(reason="uses the shared solve_async threads")
+def test_solve_async_with_asyncio():
+    solver = scs.SCS(data, cone, verbose=False)
+    ref = solver.solve()
+
+    async def main():
+        return await asyncio.gather(
+            *(asyncio.wrap_future(solver.solve_async()) for _ in range(4)))
+
+    for sol in asyncio.run(main()):
+        assert_almost_equal(sol["x"], ref["x"], decimal=4)
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_settings_and_cone_spec_match_kwargs(solver_opts):
+    ref = scs.SCS(data, cone, verbose=False, eps_abs=1e-6, **solver_opts)
+    ref_sol = ref.solve()
+    stgs = scs.Settings(verbose=False, eps_abs=1e-6, **solver_opts)
+    spec = scs.ConeSpec(cone, **solver_opts)
+    # Both are reusable across instances.
+    for _ in range(3):
+        solver = scs.SCS(data, spec, settings=stgs)
+        assert solver._settings == ref._settings
+        assert solver._linear_solver == ref._linear_solver
+        sol = solver.solve()
+        assert_almost_equal(sol["x"], ref_sol["x"], decimal=4)
+        assert sol["info"]["iter"] == ref_sol["info"]["iter"]
+    # A ConeSpec parsed for one backend also works with the others.
+    solver = scs.SCS(data, scs.ConeSpec(cone), settings=stgs)
+    assert_almost_equal(solver.solve()["x"], ref_sol["x"], decimal=4)
+
+
+def test_settings_keeps_python_settings():
+    iters = []
+    stgs = scs.Settings(verbose=False, callback=lambda s: iters.append(
+        s["iter"]), trace_stride=1)
+    sol = scs.SCS(data, cone, settings=stgs).solve(warm_start=False)
+    assert iters
+    assert len(sol["info"]["trace"]) > 0
+
+
+def test_settings_and_cone_spec_validate():
+    with pytest.raises(ValueError):
+        scs.Settings(eps_abs=-1.0)
+    with pytest.raises(TypeError):
+        scs.Settings(max_iters="many")
+    with pytest.raises(TypeError):
+        scs.Settings(not_a_setting=1)
+    with pytest.raises(ValueError):
+        scs.ConeSpec({"q": ["a"]})
+    stgs = scs.Settings(verbose=False)
+    with pytest.raises(TypeError, match="combined"):
+        scs.SCS(data, cone, settings=stgs, max_iters=10)
+    with pytest.raises(TypeError):
+        scs.SCS(data, cone, settings={"verbose": False})
+    with pytest.raises(TypeError):
+        scs.SCSPool(data, cone, workers=1, callback=print)
+    # The extension checks the same at its own level.
+    args = scs._prepare_data(data, cone)
+    with pytest.raises(TypeError, match="combined"):
+        scs._scs_direct.SCS(*args, cone, settings=stgs._parsed, verbose=False)
+    with pytest.raises(TypeError, match="cone"):
+        scs._scs_direct.SCS(*args, [("l", 2)], verbose=False)
+
+
+def test_settings_and_cone_spec_are_immutable(tmp_path):
+    path = str(tmp_path / "a.bin")
+    stgs = scs.Settings(verbose=False, write_data_filename=path)
+    spec = scs.ConeSpec({"l": 2})
+    # The extension objects are built in __new__; __init__ changes nothing.
+    stgs._parsed.__init__(verbose=True, write_data_filename="b.bin")
+    assert stgs._settings["write_data_filename"] == path
+    spec._for(scs._scs_direct).__init__({"l": 5})
+    with pytest.raises(TypeError):
+        stgs._settings["max_iters"] = 1
+    with pytest.raises(TypeError):
+        spec._cone["l"] = 5
+    s1 = scs.SCS(data, spec, settings=stgs)
+    s2 = scs.SCS(data, spec, settings=stgs)
+    s1._settings["max_iters"] = 1
+    s1._cone["l"] = 5
+    assert "max_iters" not in s2._settings
+    assert s2._cone == {"l": 2}
+    assert s2.solve()["x"].shape == (1,)
+
+
+@pytest.mark.parametrize("solver_opts", _solver_configs)
+def test_problem_template_matches_scs(solver_opts):
+    qp = _qp_with_unsorted_pattern()
+    template = scs.ProblemTemplate(qp["A"], qp["P"], cone, verbose=False,
+                                   **solver_opts)
+    for scale in (1.0, 2.0, 3.0):
+        ref = scs.SCS(
+            dict(qp, A=qp["A"] * scale, P=qp["P"] * scale, b=b * scale),
+            cone, verbose=False, **solver_opts).solve()
+        # Values in the order of the (unsorted) pattern's data.
+        solver = template.instantiate(
+            qp["A"].data * scale, qp["P"].data * scale, b * scale, c)
+        assert solver.converted_inputs == ()
+        sol = solver.solve()
+        assert_almost_equal(sol["x"], ref["x"], decimal=6)
+        assert_almost_equal(sol["y"], ref["y"], decimal=6)
+
+
+def test_problem_template_instantiate_skips_canonicalization(monkeypatch):
+    qp = _qp_with_unsorted_pattern()
+    template = scs.ProblemTemplate(qp["A"], qp["P"], cone, verbose=False)
+    ref = scs.SCS(qp, cone, verbose=False).solve()
+
+    def fail(*args, **kwargs):
+        raise AssertionError("instantiate canonicalized a pattern")
+
+    # The patterns were canonicalized once, by the constructor.
+    monkeypatch.setattr(scs, "_canonical_csc", fail)
+    monkeypatch.setattr(scs._IndexCache, "canonical", fail)
+    sol = template.instantiate(qp["A"].data, qp["P"].data, b, c).solve()
+    assert_almost_equal(sol["x"], ref["x"], decimal=6)
+
+
+def test_problem_template_accepts_csc_tuples():
+    qp = _qp_with_unsorted_pattern()
+    A, P = qp["A"], qp["P"]
+    want = scs.ProblemTemplate(A, P, cone, verbose=False, keep_problem=True)
+    got = scs.ProblemTemplate(
+        (A.data, A.indices, A.indptr), (P.data, P.indices, P.indptr), cone,
+        shape=A.shape, verbose=False, keep_problem=True)
+    solvers = [t.instantiate(A.data, P.data, [1, 0], [-1])
+               for t in (want, got)]
+    snaps = [s._solver._problem_dump() for s in solvers]
+    for g, w in zip(snaps[1][:9], snaps[0][:9]):
+        np.testing.assert_array_equal(g, w)
+    assert snaps[1][7].dtype == np.float64
+    with pytest.raises(ValueError, match="shape"):
+        scs.ProblemTemplate((A.data, A.indices, A.indptr), None, cone)
+    with pytest.raises(ValueError, match="shape"):
+        scs.ProblemTemplate(A, None, cone, shape=(3, 1))
+
+
+def test_problem_template_drops_lower_triangle_and_validates():
+    P = sp.csc_matrix(np.array([[2.0, 1.0], [1.0, 3.0]]))
+    A = sp.csc_matrix(np.eye(2))
+    template = scs.ProblemTemplate(A, P, scs.ConeSpec({"l": 2}),
+                                   verbose=False, keep_problem=True)
+    solver = template.instantiate(A.data, P.data, np.ones(2), np.ones(2))
+    ref = scs._prepare_data({"A": A, "P": P, "b": np.ones(2),
+                             "c": np.ones(2)}, {"l": 2})
+    snap = solver._solver._problem_dump()
+    for got, want in zip(snap[1:7], ref[1:7]):
+        np.testing.assert_array_equal(got, want)
+    with pytest.raises(ValueError):
+        template.instantiate(A.data[:1], P.data, np.ones(2), np.ones(2))
+    with pytest.raises(ValueError):
+        template.instantiate(A.data, None, np.ones(2), np.ones(2))
+    with pytest.raises(ValueError):
+        template.instantiate(A.data, P.data, np.ones(3), np.ones(2))
+    lp = scs.ProblemTemplate(A, None, {"l": 2}, verbose=False)
+    with pytest.raises(ValueError):
+        lp.instantiate(A.data, P.data, np.ones(2), np.ones(2))
+    lp.instantiate(A.data, None, np.ones(2), np.ones(2))
+    with pytest.raises(TypeError):
+        scs.ProblemTemplate(A.tocsr(), None, {"l": 2})
+    with pytest.raises(ValueError):
+        scs.ProblemTemplate(A, sp.csc_matrix(np.eye(3)), {"l": 2})
+
+
+def test_import_loads_no_extension_or_scipy():
+    code = ("import sys, scs; print(sorted(m for m in sys.modules "
+            "if m.startswith(('scs._scs', 'scipy', 'concurrent', "
+            "'threading', 'queue', 'hashlib', 'json', 'mmap'))))")
+    out = subprocess.check_output([sys.executable, "-c", code], text=True)
+    assert out.strip() == "[]"
+
+
+def test_lazy_module_attributes_and_preload():
+    assert scs.__version__ == scs._scs_direct.version()
+    assert scs.__sizeof_int__ == scs._scs_direct.sizeof_int()
+    scs.preload(scs.LinearSolver.QDLDL)
+    scs.preload("cpu_indirect")
+    assert "scs._scs_indirect" in sys.modules
+    with pytest.raises(ValueError):
+        scs.preload("not_a_solver")
+    with pytest.raises(AttributeError):
+        scs.not_an_attribute
+
+
+@pytest.mark.thread_unsafe(reason="mutates the global index cache")
+@pytest.mark.parametrize("cached", [False, True])
+def test_raw_csc_tuples_match_sparse_matrices(cached, index_cache):
+    scs.set_index_cache_limit((1 << 20) if cached else 0)
+    P = sp.csc_matrix(np.array([[2.0, 1.0], [1.0, 3.0]]))
+    A = sp.csc_matrix(
+        (np.array([-1.0, 1.0, 2.0]), np.array([1, 0, 1]),
+         np.array([0, 2, 3])), shape=(2, 2))
+    qp = {"A": A, "P": P, "b": np.ones(2), "c": np.ones(2)}
+    raw = dict(qp, A=(A.data, A.indices, A.indptr),
+               P=(P.data, P.indices, P.indptr))
+    want = scs._prepare_data(qp, cone, np.dtype(np.int64))
+    got = scs._prepare_data(raw, cone, np.dtype(np.int64))
+    for g, w in zip(got[1:7], want[1:7]):
+        np.testing.assert_array_equal(g, w)
+    ref = scs.SCS(qp, cone, verbose=False).solve()
+    sol = scs.SCS(raw, cone, verbose=False).solve()
+    assert_almost_equal(sol["x"], ref["x"], decimal=6)
+    with pytest.raises(ValueError):
+        scs._prepare_data(dict(raw, A=(A.data, A.indices)), cone)
+    with pytest.raises(ValueError):
+        scs._prepare_data(dict(raw, A=(A.data, A.indices, A.indptr[:-1])),
+                          cone)
+    for bad in ((A.data, A.indices, np.array([1, 2, 3])),  # indptr[0] != 0
+                (A.data, A.indices, np.array([0, 4, 3])),  # decreasing
+                (A.data, np.array([1, 0, 2]), A.indptr),  # row 2 of 2
+                (A.data, np.array([1, -1, 1]), A.indptr)):
+        with pytest.raises(ValueError, match="CSC"):
+            scs._prepare_data(dict(raw, A=bad), cone)
+    with pytest.raises(TypeError):
+        scs._prepare_data(dict(raw, A=A.toarray()), cone)
+    with pytest.raises(TypeError, match="floating"):
+        scs._prepare_data(dict(raw, A=(A.indices, A.indices, A.indptr)), cone)
+    with pytest.raises(TypeError, match="integer"):
+        scs._prepare_data(dict(raw, A=(A.data, A.data, A.indptr)), cone)
@@ -0,0 +1,122 @@
+"""Tests for SCSPool, the multi-worker solver pool."""
+import gc
+import threading
+
+import numpy as np
+import pytest
+import scipy.sparse as sp
+from numpy.testing import assert_almost_equal
+
+import scs
+
+
+def _make_simple_lp():
+    """Simple LP: max x s.t. 0 <= x <= 1. Optimal x=1."""
+    A = sp.csc_matrix([1.0, -1.0]).T.tocsc()
+    b = np.array([1.0, 0.0])
+    c = np.array([-1.0])
+    return {"A": A, "b": b, "c": c}, {"l": 2}
+
+
+@pytest.mark.thread_unsafe(reason="creates its own threads internally")
+class TestSCSPool:
+
+    def test_submit_defaults_to_original_data(self):
+        data, cone = _make_simple_lp()
+        with scs.SCSPool(data, cone, workers=2, verbose=False) as pool:
+            assert pool.workers == 2
+            sol = pool.submit().result(timeout=30)
+        assert sol["info"]["status_val"] == scs.SOLVED
+        assert_almost_equal(sol["x"][0], 1.0, decimal=2)
+
+    def test_jobs_do_not_leak_between_each_other(self):
+        # Each job is solved relative to the pool's b/c, so a c-only job
+        # after a b-only job on the same worker still sees the original b.
+        data, cone = _make_simple_lp()
+        with scs.SCSPool(data, cone, workers=1, verbose=False) as pool:
+            pool.submit(b=np.array([1.0, 1.0])).result(timeout=30)
+            sol = pool.submit(c=np.array([-1.0])).result(timeout=30)
+        assert_almost_equal(sol["x"][0], 1.0, decimal=2)
+
+    def test_solve_many_matches_individual_solves(self):
+        data, cone = _make_simple_lp()
+        jobs = [
+            {"c": np.array([-1.0])},
+            {"c": np.array([1.0])},
+            {"b": np.array([1.0, 1.0]), "c": np.array([1.0])},
+        ] * 4
+        expected = [1.0, 0.0, -1.0] * 4
+        with scs.SCSPool(data, cone, workers=3, verbose=False) as pool:
+            results = dict(pool.solve_many(jobs))
+        assert sorted(results) == list(range(len(jobs)))
+        for i, sol in results.items():
+            assert_almost_equal(sol["x"][0], expected[i], decimal=2)
+
+    def test_job_error_is_reported_on_future(self):
+        data, cone = _make_simple_lp()
+        with scs.SCSPool(data, cone, workers=2, verbose=False) as pool:
+            with pytest.raises(ValueError):
+                pool.submit(c=np.ones(3)).result(timeout=30)
+            # The worker survives a failed job.
+            sol = pool.submit().result(timeout=30)
+        assert_almost_equal(sol["x"][0], 1.0, decimal=2)
+
+    def test_setup_error_is_raised_from_constructor(self):
+        data, cone = _make_simple_lp()
+        with pytest.raises(ValueError, match="scale"):
+            scs.SCSPool(data, cone, workers=2, scale=-1.0)
+
+    def test_submit_after_close_raises(self):
+        data, cone = _make_simple_lp()
+        pool = scs.SCSPool(data, cone, workers=1, verbose=False)
+        pool.close()
+        with pytest.raises(RuntimeError):
+            pool.submit()
+
+    def test_cancel_drops_or_stops_job(self):
+        data, cone = _make_simple_lp()
+        with scs.SCSPool(data, cone, workers=1, verbose=False) as pool:
+            futs = [pool.submit(warm_start=False) for _ in range(8)]
+            for fut in futs:
+                fut.cancel()
+            # Each job was either dropped before it started or stopped
+            # (or finished) while running; none fails.
+            for fut in futs:
+                if not fut.cancelled():
+                    status = fut.result(timeout=30)["info"]["status_val"]
+                    assert status in (scs.SOLVED, scs.SIGINT)
+            assert_almost_equal(pool.submit().result(timeout=30)["x"][0],
+                                1.0, decimal=2)
+
+    def test_submit_racing_close_never_strands_a_job(self):
+        data, cone = _make_simple_lp()
+        pool = scs.SCSPool(data, cone, workers=2, verbose=False)
+        futs = []
+
+        def submitter():
+            while True:
+                try:
+                    futs.append(pool.submit())
+                except RuntimeError:
+                    return
+
+        threads = [threading.Thread(target=submitter) for _ in range(4)]
+        for t in threads:
+            t.start()
+        pool.close()
+        for t in threads:
+            t.join()
+        # Every accepted job was solved before the workers stopped.
+        for fut in futs:
+            assert fut.result(timeout=30)["info"]["status_val"] == scs.SOLVED
+
+    def test_unclosed_pool_stops_workers_when_collected(self):
+        data, cone = _make_simple_lp()
+        pool = scs.SCSPool(data, cone, workers=2, verbose=False)
+        pool.submit().result(timeout=30)
+        threads = list(pool._threads)
+        del pool
+        gc.collect()
+        for t in threads:
+            t.join(timeout=30)
+            assert not t.is_alive()